@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef KOI_STATIC_ALLOCATORS_BENCHMARK_HPP
+#define KOI_STATIC_ALLOCATORS_BENCHMARK_HPP
+
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace KoiBenchmark {
+
+/**
+ * Gets the current time of a monotonic clock in nanoseconds.
+ */
+inline uint64_t now_ns() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+/**
+ * Stores the given pointer somewhere the optimizer can't see through, so the work that produced it isn't discarded.
+ */
+inline void do_not_optimize(void* ptr) {
+    void* volatile sink = ptr;
+    (void)sink;
+}
+
+} // KoiBenchmark
+
+#endif //KOI_STATIC_ALLOCATORS_BENCHMARK_HPP
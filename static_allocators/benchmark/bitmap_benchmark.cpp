@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Compares a koi_pool_t, which spends a Block header on each allocation, with a koi_bitmap_t, which keeps its metadata
+ * in bitmaps out of band. Measures how many small allocations of each size fit in the same memory, then the speed of
+ * random small allocations and frees with a fixed number live.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+#include "static_allocators/bitmap_allocator.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+static const size_t buffer_bytes = 4u * 1024u * 1024u;
+static const size_t live_count = 4096u;
+static const size_t operation_count = 4000000u;
+
+
+struct PoolAllocator {
+    koi_pool_t pool;
+
+    void init(void* buffer, size_t bytes) {
+        koi_pool_init(&pool, buffer, bytes);
+    }
+
+    void* alloc(size_t size) {
+        return koi_pool_alloc(&pool, size);
+    }
+
+    void free(void* ptr) {
+        koi_pool_free(&pool, ptr);
+    }
+};
+
+
+struct BitmapAllocator {
+    koi_bitmap_t bitmap;
+
+    void init(void* buffer, size_t bytes) {
+        koi_bitmap_init(&bitmap, buffer, bytes);
+    }
+
+    void* alloc(size_t size) {
+        return koi_bitmap_alloc(&bitmap, size);
+    }
+
+    void free(void* ptr) {
+        koi_bitmap_free(&bitmap, ptr);
+    }
+};
+
+
+/**
+ * Allocates the given size until the allocator is full.
+ * @return The number of allocations that fit.
+ */
+template<typename Allocator>
+static size_t fill(std::vector<char>& buffer, size_t size) {
+    Allocator allocator;
+    allocator.init(buffer.data(), buffer.size());
+
+    size_t count = 0u;
+    while (allocator.alloc(size) != nullptr) {
+        ++count;
+    }
+
+    return count;
+}
+
+
+/**
+ * Replaces a random live allocation with a new one of a random size, operation_count times.
+ * @return The nanoseconds per alloc and free pair.
+ */
+template<typename Allocator>
+static double churn(std::vector<char>& buffer, size_t max_size) {
+    Allocator allocator;
+    allocator.init(buffer.data(), buffer.size());
+
+    std::mt19937 random(1u);
+    std::uniform_int_distribution<size_t> pick_size(1u, max_size);
+    std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+    std::vector<void*> live(live_count, nullptr);
+
+    for (void*& ptr : live) {
+        ptr = allocator.alloc(pick_size(random));
+    }
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t i = 0u; i < operation_count; ++i) {
+        size_t slot = pick_slot(random);
+        allocator.free(live[slot]);
+        live[slot] = allocator.alloc(pick_size(random));
+        KoiBenchmark::do_not_optimize(live[slot]);
+    }
+    uint64_t elapsed = KoiBenchmark::now_ns() - begin;
+
+    for (void* ptr : live) {
+        allocator.free(ptr);
+    }
+
+    return (double)elapsed / (double)operation_count;
+}
+
+
+int main() {
+    const size_t fill_sizes[] = {8u, 16u, 32u, 64u, 128u, 256u};
+    const size_t churn_sizes[] = {64u, 256u, 1024u};
+
+    std::vector<char> buffer(buffer_bytes);
+
+    printf("allocations of 1 size that fit in %zu MB, and the bytes lost to metadata and rounding\n",
+           buffer_bytes / (1024u * 1024u));
+    printf("%10s %12s %12s %12s %12s\n", "bytes", "pool count", "pool lost", "bitmap count", "bitmap lost");
+
+    for (size_t size : fill_sizes) {
+        size_t pool_count = fill<PoolAllocator>(buffer, size);
+        size_t bitmap_count = fill<BitmapAllocator>(buffer, size);
+
+        printf("%10zu %12zu %11.1f%% %12zu %11.1f%%\n", size,
+               pool_count, 100.0 * (1.0 - (double)(pool_count * size) / (double)buffer_bytes),
+               bitmap_count, 100.0 * (1.0 - (double)(bitmap_count * size) / (double)buffer_bytes));
+    }
+
+    printf("\nrandom frees and allocations of 1 to max bytes with %zu live\n", live_count);
+    printf("%10s %12s %12s\n", "max bytes", "pool ns/op", "bitmap ns/op");
+
+    for (size_t size : churn_sizes) {
+        double pool_ns = churn<PoolAllocator>(buffer, size);
+        double bitmap_ns = churn<BitmapAllocator>(buffer, size);
+
+        printf("%10zu %12.1f %12.1f\n", size, pool_ns, bitmap_ns);
+    }
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures node based standard containers with std::allocator against Koi::PoolAllocator over a koi_pool_t, and
+ * against Koi::PoolMemoryResource when std::pmr is available. Each round inserts random keys and then erases them in a
+ * different random order, so every node is allocated and freed once per round.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/pool_allocator.hpp"
+#include "static_allocators/pool_memory_resource.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <list>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+
+static const size_t key_count = 100000u;
+static const size_t round_count = 20u;
+
+
+/**
+ * Runs the rounds on the given container.
+ * @return The nanoseconds per inserted and erased key.
+ */
+template<typename Container, typename Insert>
+static double run(Container& container, const std::vector<int>& inserts, const std::vector<int>& erases,
+                  Insert insert) {
+    uint64_t begin = KoiBenchmark::now_ns();
+
+    for (size_t round = 0u; round < round_count; ++round) {
+        for (int key : inserts) {
+            insert(container, key);
+        }
+
+        for (int key : erases) {
+            container.erase(key);
+        }
+    }
+
+    return (double)(KoiBenchmark::now_ns() - begin) / (double)(round_count * key_count);
+}
+
+
+/**
+ * Inserts a key into a map, working with any of the map types.
+ */
+struct InsertMap {
+    template<typename Map>
+    void operator()(Map& map, int key) const {
+        map.emplace(key, key);
+    }
+};
+
+
+/**
+ * Runs std::list separately since it erases by iterator, popping from the front instead of by key.
+ */
+template<typename List>
+static double run_list(List& list) {
+    uint64_t begin = KoiBenchmark::now_ns();
+
+    for (size_t round = 0u; round < round_count; ++round) {
+        for (size_t i = 0u; i < key_count; ++i) {
+            list.push_back((int)i);
+        }
+
+        while (!list.empty()) {
+            list.pop_front();
+        }
+    }
+
+    return (double)(KoiBenchmark::now_ns() - begin) / (double)(round_count * key_count);
+}
+
+
+int main() {
+    std::vector<int> inserts(key_count);
+    for (size_t i = 0u; i < key_count; ++i) {
+        inserts[i] = (int)i;
+    }
+
+    std::mt19937 random(7u);
+    std::shuffle(inserts.begin(), inserts.end(), random);
+    std::vector<int> erases = inserts;
+    std::shuffle(erases.begin(), erases.end(), random);
+
+    // each container type starts from fresh pools, 1 for PoolAllocator and 1 for PoolMemoryResource
+    std::vector<char> buffer(64u * 1024u * 1024u);
+    std::vector<char> resource_buffer(64u * 1024u * 1024u);
+    koi_pool_t pool;
+    koi_pool_t resource_pool;
+
+    InsertMap insert_map;
+    Koi::PoolAllocator<int> allocator(&pool);
+
+    printf("%zu keys inserted and erased %zu times, ns per key\n", key_count, round_count);
+    printf("%-20s %16s %16s", "container", "std::allocator", "PoolAllocator");
+#ifdef __cpp_lib_memory_resource
+    printf(" %16s", "memory_resource");
+#endif
+    printf("\n");
+
+    {
+        koi_pool_init(&pool, buffer.data(), buffer.size());
+        koi_pool_init(&resource_pool, resource_buffer.data(), resource_buffer.size());
+
+        std::map<int, int> std_map;
+        std::map<int, int, std::less<int>, Koi::PoolAllocator<std::pair<const int, int>>> pool_map(allocator);
+
+        printf("%-20s %16.1f %16.1f", "std::map",
+               run(std_map, inserts, erases, insert_map), run(pool_map, inserts, erases, insert_map));
+#ifdef __cpp_lib_memory_resource
+        Koi::PoolMemoryResource resource(&resource_pool);
+        std::pmr::map<int, int> pmr_map(&resource);
+        printf(" %16.1f", run(pmr_map, inserts, erases, insert_map));
+#endif
+        printf("\n");
+    }
+
+    {
+        koi_pool_init(&pool, buffer.data(), buffer.size());
+        koi_pool_init(&resource_pool, resource_buffer.data(), resource_buffer.size());
+
+        std::unordered_map<int, int> std_map;
+        std::unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+                Koi::PoolAllocator<std::pair<const int, int>>> pool_map(
+                0u, std::hash<int>(), std::equal_to<int>(), allocator
+        );
+
+        printf("%-20s %16.1f %16.1f", "std::unordered_map",
+               run(std_map, inserts, erases, insert_map), run(pool_map, inserts, erases, insert_map));
+#ifdef __cpp_lib_memory_resource
+        Koi::PoolMemoryResource resource(&resource_pool);
+        std::pmr::unordered_map<int, int> pmr_map(&resource);
+        printf(" %16.1f", run(pmr_map, inserts, erases, insert_map));
+#endif
+        printf("\n");
+    }
+
+    {
+        koi_pool_init(&pool, buffer.data(), buffer.size());
+        koi_pool_init(&resource_pool, resource_buffer.data(), resource_buffer.size());
+
+        std::list<int> std_list;
+        std::list<int, Koi::PoolAllocator<int>> pool_list(allocator);
+
+        printf("%-20s %16.1f %16.1f", "std::list", run_list(std_list), run_list(pool_list));
+#ifdef __cpp_lib_memory_resource
+        Koi::PoolMemoryResource resource(&resource_pool);
+        std::pmr::list<int> pmr_list(&resource);
+        printf(" %16.1f", run_list(pmr_list));
+#endif
+        printf("\n");
+    }
+
+    return 0;
+}
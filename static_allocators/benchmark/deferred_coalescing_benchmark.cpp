@@ -0,0 +1,185 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Compares eager merging of freed allocations with deferred merging through the size classes on churn-heavy
+ * workloads. It is built once per mode: eager (no size classes), the default size classes, deferred (size classes up to
+ * 4096 bytes, merging only when an allocation misses) and deferred with a KOI_SIZE_CLASS_FLUSH_THRESHOLD, under first
+ * and best fit.
+ * same size: random frees of 2048 byte allocations, each replaced by another of the same size.
+ * churn: the same with random sizes from 16 to 4096 bytes.
+ * phase change: the churn workload, then everything is freed and the pool is filled with 256 KB allocations, which
+ * only fit once the parked allocations have merged.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+#if KOI_SIZE_CLASS_MAX_SIZE == 0u
+static const char* mode_name = "eager";
+#elif KOI_SIZE_CLASS_FLUSH_THRESHOLD > 0u && KOI_FIT_POLICY == KOI_FIT_BEST
+static const char* mode_name = "deferred with threshold, best fit";
+#elif KOI_SIZE_CLASS_FLUSH_THRESHOLD > 0u
+static const char* mode_name = "deferred with threshold";
+#else
+static const char* mode_name = "deferred";
+#endif
+
+static const size_t buffer_bytes = 64u * 1024u * 1024u;
+static const size_t live_count = 4096u;
+static const size_t operation_count = 1000000u;
+static const size_t large_size = 256u * 1024u;
+
+
+/**
+ * The results of 1 workload. The stats are taken when its timed part ends.
+ */
+struct Result {
+    uint64_t elapsed_ns = 0u;
+    size_t operations = 0u;
+    size_t failures = 0u;
+    koi_pool_stats_t stats;
+};
+
+
+/**
+ * Replaces a random live allocation with a new one of a size from pick_size, operation_count times.
+ */
+template<typename PickSize>
+static Result run_churn(koi_pool_t* pool, std::vector<void*>& live, PickSize pick_size) {
+    Result result;
+    std::mt19937 random(1u);
+    std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+
+    for (void*& ptr : live) {
+        ptr = koi_pool_alloc(pool, pick_size(random));
+    }
+
+    // generate the workload up front so only the allocator is timed
+    std::vector<size_t> sizes(operation_count);
+    std::vector<size_t> slots(operation_count);
+    for (size_t i = 0u; i < operation_count; ++i) {
+        sizes[i] = pick_size(random);
+        slots[i] = pick_slot(random);
+    }
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t i = 0u; i < operation_count; ++i) {
+        koi_pool_free(pool, live[slots[i]]);
+        live[slots[i]] = koi_pool_alloc(pool, sizes[i]);
+
+        if (live[slots[i]] == nullptr) {
+            ++result.failures;
+        }
+    }
+    result.elapsed_ns = KoiBenchmark::now_ns() - begin;
+    result.operations = 2u * operation_count;
+
+    koi_pool_get_stats(pool, &result.stats);
+
+    return result;
+}
+
+
+static size_t pick_same(std::mt19937&) {
+    return 2048u;
+}
+
+
+static size_t pick_uniform(std::mt19937& random) {
+    return std::uniform_int_distribution<size_t>(16u, 4096u)(random);
+}
+
+
+/**
+ * Churns, frees everything, then times filling the pool with large allocations.
+ */
+static Result run_phase_change(koi_pool_t* pool, std::vector<void*>& live) {
+    run_churn(pool, live, pick_uniform);
+
+    for (void*& ptr : live) {
+        koi_pool_free(pool, ptr);
+        ptr = nullptr;
+    }
+
+    Result result;
+    std::vector<void*> large;
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t i = 0u; i < buffer_bytes / large_size; ++i) {
+        void* ptr = koi_pool_alloc(pool, large_size);
+        if (ptr != nullptr) {
+            large.push_back(ptr);
+        }
+    }
+    result.elapsed_ns = KoiBenchmark::now_ns() - begin;
+    result.operations = buffer_bytes / large_size;
+
+    // the pool's blocks leave room for 1 less, so count failures beyond that
+    result.failures = result.operations - 1u - large.size();
+
+    koi_pool_get_stats(pool, &result.stats);
+
+    for (void* ptr : large) {
+        koi_pool_free(pool, ptr);
+    }
+
+    return result;
+}
+
+
+static void print(const char* name, const Result& result) {
+    printf("%14s %10.1f %14.3f %16.1f %10zu\n", name, (double)result.elapsed_ns / (double)result.operations,
+           result.stats.fragmentation, (double)result.stats.size_class_bytes / 1024.0, result.failures);
+}
+
+
+int main() {
+    std::vector<char> buffer(buffer_bytes);
+    std::vector<void*> live(live_count, nullptr);
+    koi_pool_t pool;
+
+    printf("%s, size classes up to %zu bytes, %zu live allocations, %zu MB pool\n", mode_name,
+           (size_t)KOI_SIZE_CLASS_MAX_SIZE, live_count, buffer_bytes / (1024u * 1024u));
+    printf("%14s %10s %14s %16s %10s\n", "workload", "ns/op", "fragmentation", "size class KB", "failures");
+
+    koi_pool_init(&pool, buffer.data(), buffer.size());
+    print("same size", run_churn(&pool, live, pick_same));
+
+    koi_pool_init(&pool, buffer.data(), buffer.size());
+    print("churn", run_churn(&pool, live, pick_uniform));
+
+    koi_pool_init(&pool, buffer.data(), buffer.size());
+    print("phase change", run_phase_change(&pool, live));
+
+    return 0;
+}
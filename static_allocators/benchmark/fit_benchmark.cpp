@@ -0,0 +1,233 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Runs synthetic workloads against a memory pool built with 1 fit policy, reporting throughput and fragmentation, so
+ * the policies can be compared by running each build. The pools are built without size classes, which would otherwise
+ * serve the small allocations before the fit policy is used.
+ * uniform: random frees and allocations of 16 to 4096 bytes with a fixed number live.
+ * bimodal: the same, but 90% of allocations are 16 to 64 bytes and the rest 4096 to 16384 bytes.
+ * LIFO: allocates a stack of random sizes, then frees it newest first.
+ * FIFO: a queue of random sizes, freeing the oldest allocation for every new one.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+
+#if KOI_FIT_POLICY == KOI_FIT_NEXT
+static const char* policy_name = "next fit";
+#elif KOI_FIT_POLICY == KOI_FIT_BEST
+static const char* policy_name = "best fit";
+#else
+static const char* policy_name = "first fit";
+#endif
+
+static const size_t buffer_bytes = 64u * 1024u * 1024u;
+static const size_t live_count = 4096u;
+static const size_t operation_count = 400000u;
+
+
+/**
+ * The results of 1 workload. Fragmentation is sampled at its peak footprint, the furthest byte into the pool any
+ * allocation reached.
+ */
+struct Result {
+    uint64_t elapsed_ns = 0u;
+    size_t operations = 0u;
+    size_t failures = 0u;
+    size_t footprint = 0u;
+    double fragmentation = 0.0;
+};
+
+
+class Workload {
+public:
+    koi_pool_t pool;
+    char* base;
+    Result result;
+
+    explicit Workload(std::vector<char>& buffer): base(buffer.data()) {
+        koi_pool_init(&pool, buffer.data(), buffer.size());
+    }
+
+    void* alloc(size_t size) {
+        void* ptr = koi_pool_alloc(&pool, size);
+        ++result.operations;
+
+        if (ptr == nullptr) {
+            ++result.failures;
+        } else if ((size_t)((char*)ptr - base) + size > result.footprint) {
+            result.footprint = (size_t)((char*)ptr - base) + size;
+
+            // only sampled when the footprint grows, which stops happening once the workload is steady
+            koi_pool_stats_t stats;
+            koi_pool_get_stats(&pool, &stats);
+            result.fragmentation = stats.fragmentation;
+        }
+
+        return ptr;
+    }
+
+    void free(void* ptr) {
+        koi_pool_free(&pool, ptr);
+        ++result.operations;
+    }
+};
+
+
+/**
+ * Replaces a random live allocation with a new one of a size from pick_size, operation_count times.
+ */
+template<typename PickSize>
+static Result run_random(std::vector<char>& buffer, PickSize pick_size) {
+    Workload workload(buffer);
+    std::mt19937 random(1u);
+    std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+    std::vector<void*> live(live_count, nullptr);
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (void*& ptr : live) {
+        ptr = workload.alloc(pick_size(random));
+    }
+
+    for (size_t i = 0u; i < operation_count; ++i) {
+        size_t slot = pick_slot(random);
+        workload.free(live[slot]);
+        live[slot] = workload.alloc(pick_size(random));
+    }
+    workload.result.elapsed_ns = KoiBenchmark::now_ns() - begin;
+
+    for (void* ptr : live) {
+        koi_pool_free(&workload.pool, ptr);
+    }
+
+    return workload.result;
+}
+
+
+static size_t pick_uniform(std::mt19937& random) {
+    return std::uniform_int_distribution<size_t>(16u, 4096u)(random);
+}
+
+
+static size_t pick_bimodal(std::mt19937& random) {
+    if (std::uniform_int_distribution<size_t>(0u, 9u)(random) == 0u) {
+        return std::uniform_int_distribution<size_t>(4096u, 16384u)(random);
+    }
+
+    return std::uniform_int_distribution<size_t>(16u, 64u)(random);
+}
+
+
+/**
+ * Pushes a stack of up to live_count allocations, then pops it, until operation_count operations were made.
+ */
+static Result run_lifo(std::vector<char>& buffer) {
+    Workload workload(buffer);
+    std::mt19937 random(1u);
+    std::uniform_int_distribution<size_t> pick_depth(1u, live_count);
+    std::vector<void*> stack;
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    while (workload.result.operations < operation_count) {
+        size_t depth = pick_depth(random);
+
+        while (stack.size() < depth) {
+            stack.push_back(workload.alloc(pick_uniform(random)));
+        }
+
+        // only pop part of the way, so the stack's bottom stays live across rounds
+        size_t keep = depth / 2u;
+        while (stack.size() > keep) {
+            workload.free(stack.back());
+            stack.pop_back();
+        }
+    }
+    workload.result.elapsed_ns = KoiBenchmark::now_ns() - begin;
+
+    for (void* ptr : stack) {
+        koi_pool_free(&workload.pool, ptr);
+    }
+
+    return workload.result;
+}
+
+
+/**
+ * Keeps a queue of live_count allocations, freeing the oldest for every new one.
+ */
+static Result run_fifo(std::vector<char>& buffer) {
+    Workload workload(buffer);
+    std::mt19937 random(1u);
+    std::deque<void*> queue;
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t i = 0u; i < live_count; ++i) {
+        queue.push_back(workload.alloc(pick_uniform(random)));
+    }
+
+    for (size_t i = 0u; i < operation_count; ++i) {
+        workload.free(queue.front());
+        queue.pop_front();
+        queue.push_back(workload.alloc(pick_uniform(random)));
+    }
+    workload.result.elapsed_ns = KoiBenchmark::now_ns() - begin;
+
+    for (void* ptr : queue) {
+        koi_pool_free(&workload.pool, ptr);
+    }
+
+    return workload.result;
+}
+
+
+static void print(const char* name, const Result& result) {
+    printf("%10s %14.2f %14.1f %14.3f %10zu\n", name,
+           (double)result.operations * 1000.0 / (double)result.elapsed_ns,
+           (double)result.footprint / (1024.0 * 1024.0), result.fragmentation, result.failures);
+}
+
+
+int main() {
+    std::vector<char> buffer(buffer_bytes);
+
+    printf("%s, %zu live allocations, %zu MB pool\n", policy_name, live_count, buffer_bytes / (1024u * 1024u));
+    printf("%10s %14s %14s %14s %10s\n", "workload", "M ops/s", "footprint MB", "fragmentation", "failures");
+
+    print("uniform", run_random(buffer, pick_uniform));
+    print("bimodal", run_random(buffer, pick_bimodal));
+    print("LIFO", run_lifo(buffer));
+    print("FIFO", run_fifo(buffer));
+
+    return 0;
+}
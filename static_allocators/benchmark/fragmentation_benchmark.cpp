@@ -0,0 +1,185 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Runs a long mixed-size workload against each allocator strategy and reports how often allocations fail early and
+ * late in the run, along with throughput. The workload allocates while the live bytes are under a target share of the
+ * memory and otherwise, or when an allocation fails, frees a random live allocation.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+#include "static_allocators/buddy_allocator.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+static const size_t memory_bytes = 4u * 1024u * 1024u;
+static const size_t operation_count = 2000000u;
+static const size_t period_count = 8u;
+
+
+/**
+ * The failure rates, in percent, of the first and last periods of a run and of the whole run.
+ */
+struct Result {
+    double first_failure_rate;
+    double last_failure_rate;
+    double failure_rate;
+    double operations_per_second;
+};
+
+
+/**
+ * Picks a size from a mix of mostly small, some medium and a few large allocations.
+ */
+static size_t pick_size(std::mt19937& random) {
+    std::uniform_int_distribution<size_t> pick_kind(0u, 99u);
+    size_t kind = pick_kind(random);
+
+    if (kind < 70u) {
+        return std::uniform_int_distribution<size_t>(16u, 256u)(random);
+    } else if (kind < 95u) {
+        return std::uniform_int_distribution<size_t>(257u, 4096u)(random);
+    }
+
+    return std::uniform_int_distribution<size_t>(4097u, 65536u)(random);
+}
+
+
+/**
+ * Runs the workload with the given functions, keeping the live bytes around the given number.
+ */
+template<typename Alloc, typename Free>
+static Result run(size_t target_live_bytes, Alloc alloc, Free free) {
+    Result result = {0.0, 0.0, 0.0, 0.0};
+    std::mt19937 random(11u);
+    std::vector<void*> live;
+    std::vector<size_t> live_sizes;
+    size_t live_bytes = 0u;
+    size_t attempts = 0u;
+    size_t failures = 0u;
+    size_t total_attempts = 0u;
+    size_t total_failures = 0u;
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t i = 1u; i <= operation_count; ++i) {
+        bool should_free = live_bytes >= target_live_bytes && !live.empty();
+
+        if (!should_free) {
+            size_t size = pick_size(random);
+            void* ptr = alloc(size);
+            ++attempts;
+
+            if (ptr == nullptr) {
+                // free something instead, so a full allocator doesn't stall the workload
+                ++failures;
+                should_free = !live.empty();
+            } else {
+                live.push_back(ptr);
+                live_sizes.push_back(size);
+                live_bytes += size;
+            }
+        }
+
+        if (should_free) {
+            size_t slot = std::uniform_int_distribution<size_t>(0u, live.size() - 1u)(random);
+            free(live[slot]);
+            live_bytes -= live_sizes[slot];
+
+            live[slot] = live.back();
+            live_sizes[slot] = live_sizes.back();
+            live.pop_back();
+            live_sizes.pop_back();
+        }
+
+        if (i % (operation_count / period_count) == 0u) {
+            double failure_rate = 100.0 * (double)failures / (double)attempts;
+
+            if (i == operation_count / period_count) {
+                result.first_failure_rate = failure_rate;
+            }
+
+            result.last_failure_rate = failure_rate;
+            total_attempts += attempts;
+            total_failures += failures;
+            attempts = 0u;
+            failures = 0u;
+        }
+    }
+    uint64_t elapsed_ns = KoiBenchmark::now_ns() - begin;
+
+    for (void* ptr : live) {
+        free(ptr);
+    }
+
+    result.failure_rate = 100.0 * (double)total_failures / (double)total_attempts;
+    result.operations_per_second = (double)operation_count * 1000.0 / (double)elapsed_ns;
+
+    return result;
+}
+
+
+static void print(const char* name, size_t live_percent, const Result& result) {
+    printf("%-12s %8zu %16.3f %16.3f %16.3f %12.2f\n", name, live_percent, result.first_failure_rate,
+           result.last_failure_rate, result.failure_rate, result.operations_per_second);
+}
+
+
+int main() {
+    const size_t live_percents[] = {50u, 65u, 80u};
+    std::vector<char> pool_buffer(memory_bytes);
+    std::vector<char> buddy_buffer(memory_bytes);
+
+    printf("%zu byte allocators, %zu operations, failure rates in %%\n", memory_bytes, operation_count);
+    printf("%-12s %8s %16s %16s %16s %12s\n", "allocator", "live %", "first 1/8 fails", "last 1/8 fails",
+           "total fails", "M ops/s");
+
+    for (size_t live_percent : live_percents) {
+        size_t target_live_bytes = memory_bytes / 100u * live_percent;
+
+        koi_pool_t pool;
+        koi_pool_init(&pool, pool_buffer.data(), pool_buffer.size());
+        print("koi_pool", live_percent, run(
+                target_live_bytes,
+                [&pool](size_t size) { return koi_pool_alloc(&pool, size); },
+                [&pool](void* ptr) { koi_pool_free(&pool, ptr); }
+        ));
+
+        koi_buddy_t buddy;
+        koi_buddy_init(&buddy, buddy_buffer.data(), buddy_buffer.size());
+        print("koi_buddy", live_percent, run(
+                target_live_bytes,
+                [&buddy](size_t size) { return koi_buddy_alloc(&buddy, size); },
+                [&buddy](void* ptr) { koi_buddy_free(&buddy, ptr); }
+        ));
+    }
+
+    return 0;
+}
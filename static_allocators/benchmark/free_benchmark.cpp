@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures koi_static_free latency while the number of live allocations in the pool grows. Each round frees a random
+ * batch of the live allocations and then allocates them again, so the pool stays at the same number of live
+ * allocations. Only the frees are timed.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+static const size_t allocation_size = 32u;
+static const size_t frees_per_live_count = 1000000u;
+static const size_t max_batch_size = 1000u;
+
+
+int main() {
+    const size_t live_counts[] = {10u, 100u, 1000u, 10000u, 100000u};
+
+    printf("koi_static_free latency, %zu byte allocations, pool of %zu blocks\n",
+           allocation_size, (size_t)KOI_MEMORY_POOL_SIZE);
+    printf("%16s %16s\n", "live allocations", "ns per free");
+
+    for (size_t live_count : live_counts) {
+        koi_static_init();
+
+        std::vector<void*> live(live_count);
+        for (size_t i = 0u; i < live_count; ++i) {
+            live[i] = koi_static_alloc(allocation_size);
+
+            if (live[i] == nullptr) {
+                printf("the memory pool is too small for %zu live allocations\n", live_count);
+                return 1;
+            }
+        }
+
+        std::vector<size_t> order(live_count);
+        for (size_t i = 0u; i < live_count; ++i) {
+            order[i] = i;
+        }
+
+        std::mt19937 random((unsigned)live_count);
+        size_t batch_size = std::max<size_t>(1u, std::min(live_count / 2u, max_batch_size));
+        uint64_t elapsed_ns = 0u;
+        size_t frees = 0u;
+
+        while (frees < frees_per_live_count) {
+            // pick a random batch of live allocations by partially shuffling the order
+            for (size_t i = 0u; i < batch_size; ++i) {
+                std::uniform_int_distribution<size_t> pick(i, live_count - 1u);
+                std::swap(order[i], order[pick(random)]);
+            }
+
+            uint64_t begin = KoiBenchmark::now_ns();
+            for (size_t i = 0u; i < batch_size; ++i) {
+                koi_static_free(live[order[i]]);
+            }
+            elapsed_ns += KoiBenchmark::now_ns() - begin;
+            frees += batch_size;
+
+            for (size_t i = 0u; i < batch_size; ++i) {
+                live[order[i]] = koi_static_alloc(allocation_size);
+                KoiBenchmark::do_not_optimize(live[order[i]]);
+            }
+        }
+
+        printf("%16zu %16.2f\n", live_count, (double)elapsed_ns / (double)frees);
+    }
+
+    return 0;
+}
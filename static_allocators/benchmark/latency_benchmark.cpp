@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures the latency distribution of single allocations and frees for each allocator strategy, since a soft-real-time
+ * loop cares about the slowest calls rather than the average. Each operation frees a random live allocation and
+ * allocates a new one of a random size in place of it, timing each call on its own.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+#include "static_allocators/buddy_allocator.h"
+#include "static_allocators/tlsf_allocator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+static const size_t memory_bytes = 32u * 1024u * 1024u;
+static const size_t live_count = 4096u;
+static const size_t operation_count = 500000u;
+
+
+/**
+ * Picks a size from a mix of mostly small and some medium allocations.
+ */
+static size_t pick_size(std::mt19937& random) {
+    if (std::uniform_int_distribution<size_t>(0u, 9u)(random) < 8u) {
+        return std::uniform_int_distribution<size_t>(16u, 256u)(random);
+    }
+
+    return std::uniform_int_distribution<size_t>(257u, 8192u)(random);
+}
+
+
+/**
+ * Prints the p50, p99, p99.9 and max of the given latencies.
+ */
+static void print(const char* name, const char* operation, std::vector<uint64_t>& latencies) {
+    std::sort(latencies.begin(), latencies.end());
+
+    printf("%-12s %-8s %10llu %10llu %10llu %10llu\n", name, operation,
+           (unsigned long long)latencies[latencies.size() / 2u],
+           (unsigned long long)latencies[latencies.size() * 99u / 100u],
+           (unsigned long long)latencies[latencies.size() * 999u / 1000u],
+           (unsigned long long)latencies.back());
+}
+
+
+/**
+ * Runs the workload with the given functions and prints its latencies.
+ */
+template<typename Alloc, typename Free>
+static void run(const char* name, Alloc alloc, Free free) {
+    std::mt19937 random(13u);
+    std::vector<void*> live(live_count);
+    std::vector<uint64_t> alloc_latencies;
+    std::vector<uint64_t> free_latencies;
+    size_t failures = 0u;
+
+    alloc_latencies.reserve(operation_count);
+    free_latencies.reserve(operation_count);
+
+    for (size_t i = 0u; i < live_count; ++i) {
+        live[i] = alloc(pick_size(random));
+    }
+
+    for (size_t i = 0u; i < operation_count; ++i) {
+        size_t slot = std::uniform_int_distribution<size_t>(0u, live_count - 1u)(random);
+        size_t size = pick_size(random);
+
+        uint64_t begin = KoiBenchmark::now_ns();
+        free(live[slot]);
+        uint64_t middle = KoiBenchmark::now_ns();
+        live[slot] = alloc(size);
+        uint64_t end = KoiBenchmark::now_ns();
+
+        free_latencies.push_back(middle - begin);
+        alloc_latencies.push_back(end - middle);
+        failures += live[slot] == nullptr;
+    }
+
+    for (void* ptr : live) {
+        free(ptr);
+    }
+
+    print(name, "alloc", alloc_latencies);
+    print(name, "free", free_latencies);
+
+    if (failures > 0u) {
+        printf("%-12s %zu allocations failed\n", name, failures);
+    }
+}
+
+
+int main() {
+    std::vector<char> buffer(memory_bytes);
+
+    printf("%zu live allocations, %zu operations, latencies in ns including the clock's overhead\n",
+           live_count, operation_count);
+    printf("%-12s %-8s %10s %10s %10s %10s\n", "allocator", "call", "p50", "p99", "p99.9", "max");
+
+    koi_pool_t pool;
+    koi_pool_init(&pool, buffer.data(), buffer.size());
+    run(
+            "koi_pool",
+            [&pool](size_t size) { return koi_pool_alloc(&pool, size); },
+            [&pool](void* ptr) { koi_pool_free(&pool, ptr); }
+    );
+
+    koi_buddy_t buddy;
+    koi_buddy_init(&buddy, buffer.data(), buffer.size());
+    run(
+            "koi_buddy",
+            [&buddy](size_t size) { return koi_buddy_alloc(&buddy, size); },
+            [&buddy](void* ptr) { koi_buddy_free(&buddy, ptr); }
+    );
+
+    koi_tlsf_t tlsf;
+    koi_tlsf_init(&tlsf, buffer.data(), buffer.size());
+    run(
+            "koi_tlsf",
+            [&tlsf](size_t size) { return koi_tlsf_alloc(&tlsf, size); },
+            [&tlsf](void* ptr) { koi_tlsf_free(&tlsf, ptr); }
+    );
+
+    run(
+            "malloc",
+            [](size_t size) { return malloc(size); },
+            [](void* ptr) { free(ptr); }
+    );
+
+    return 0;
+}
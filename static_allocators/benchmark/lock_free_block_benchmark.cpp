@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures alloc/free throughput of fixed-size blocks under contention, from 1 thread to twice the hardware threads,
+ * where threads holding a lock get preempted. Each thread allocates a few message buffers and frees them. Compares the
+ * lock-free block pool against a slab, the other allocator for 1 object size, behind a single mutex.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/lock_free_block_pool.hpp"
+#include "static_allocators/slab_allocator.h"
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+static const size_t message_size = 64u;
+static const size_t message_count = 65536u;
+static const size_t burst_size = 8u;
+static const size_t operations_per_thread = 2000000u;
+
+
+/**
+ * Runs thread_count threads that each allocate burst_size blocks then free them, until each made
+ * operations_per_thread allocations.
+ * @return Millions of alloc/free pairs per second over all threads, or a negative number if an allocation failed.
+ */
+template<typename Alloc, typename Free>
+static double run(size_t thread_count, Alloc alloc, Free free) {
+    std::vector<std::thread> threads;
+    std::vector<int> failed(thread_count, 0);
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t t = 0u; t < thread_count; ++t) {
+        threads.emplace_back([&alloc, &free, &failed, t]() {
+            void* burst[burst_size];
+
+            for (size_t i = 0u; i < operations_per_thread; i += burst_size) {
+                for (void*& ptr : burst) {
+                    ptr = alloc();
+                    failed[t] |= ptr == nullptr;
+                    KoiBenchmark::do_not_optimize(ptr);
+                }
+
+                for (void* ptr : burst) {
+                    free(ptr);
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    uint64_t elapsed_ns = KoiBenchmark::now_ns() - begin;
+
+    for (int f : failed) {
+        if (f != 0) {
+            return -1.0;
+        }
+    }
+
+    return (double)(thread_count * operations_per_thread) * 1000.0 / (double)elapsed_ns;
+}
+
+
+int main() {
+    static Koi::LockFreeBlockPool<message_size, message_count> lock_free_pool;
+    static unsigned char slab_buffer[message_size * message_count];
+    size_t hardware_threads = std::thread::hardware_concurrency();
+    hardware_threads = hardware_threads == 0u ? 1u : hardware_threads;
+
+    printf("%zu alloc/free pairs of %zu byte blocks per thread, in bursts of %zu, M pairs/s\n",
+           operations_per_thread, message_size, burst_size);
+    printf("lock-free head: %s\n", lock_free_pool.is_lock_free() ? "yes" : "no, emulated with a lock");
+    printf("%10s %14s %14s\n", "threads", "lock-free", "mutex");
+
+    for (size_t thread_count = 1u; thread_count <= 2u * hardware_threads; thread_count *= 2u) {
+        double lock_free = run(thread_count, []() {
+            return lock_free_pool.alloc();
+        }, [](void* ptr) {
+            lock_free_pool.free(ptr);
+        });
+
+        koi_slab_t slab;
+        koi_slab_init(&slab, slab_buffer, sizeof(slab_buffer), message_size, 16u);
+        std::mutex mutex;
+
+        double locked = run(thread_count, [&slab, &mutex]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return koi_slab_alloc(&slab);
+        }, [&slab, &mutex](void* ptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            koi_slab_free(&slab, ptr);
+        });
+
+        printf("%10zu %14.2f %14.2f\n", thread_count, lock_free, locked);
+    }
+
+    return 0;
+}
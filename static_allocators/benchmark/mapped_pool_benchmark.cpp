@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures pools from koi_pool_map with and without transparent huge pages. Fills a pool with page-sized allocations,
+ * timing the first write to each, which is when its memory is committed, then reads them in a random order, which
+ * misses the TLB on almost every read unless huge pages cover more memory per entry.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/mapped_pool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+static const size_t pool_bytes = 1024u * 1024u * 1024u;
+static const size_t allocation_bytes = 4096u;
+static const size_t read_count = 20000000u;
+
+
+static void run(const char* name, unsigned int flags) {
+    koi_pool_t pool;
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    if (!koi_pool_map(&pool, pool_bytes, flags)) {
+        printf("%12s couldn't map the pool\n", name);
+        return;
+    }
+    double map_us = (double)(KoiBenchmark::now_ns() - begin) / 1000.0;
+
+    std::vector<unsigned char*> allocations;
+    allocations.reserve(pool_bytes / allocation_bytes);
+
+    // the first write to each allocation commits its memory
+    begin = KoiBenchmark::now_ns();
+    while (true) {
+        unsigned char* ptr = (unsigned char*)koi_pool_alloc(&pool, allocation_bytes);
+        if (ptr == nullptr) {
+            break;
+        }
+
+        ptr[0u] = (unsigned char)allocations.size();
+        ptr[allocation_bytes - 1u] = ptr[0u];
+        allocations.push_back(ptr);
+    }
+    double commit_ns = (double)(KoiBenchmark::now_ns() - begin) / (double)allocations.size();
+
+    std::mt19937 random(1u);
+    std::shuffle(allocations.begin(), allocations.end(), random);
+
+    size_t sum = 0u;
+    begin = KoiBenchmark::now_ns();
+    for (size_t i = 0u; i < read_count; ++i) {
+        sum += allocations[i % allocations.size()][allocation_bytes / 2u];
+    }
+    double read_ns = (double)(KoiBenchmark::now_ns() - begin) / (double)read_count;
+    KoiBenchmark::do_not_optimize((void*)(uintptr_t)sum);
+
+    printf("%12s %12.1f %16.1f %14.2f\n", name, map_us, commit_ns, read_ns);
+
+    for (unsigned char* ptr : allocations) {
+        koi_pool_free(&pool, ptr);
+    }
+
+    koi_pool_unmap(&pool);
+}
+
+
+int main() {
+    printf("%zu MB pool of %zu byte allocations, %zu random reads\n", pool_bytes / (1024u * 1024u), allocation_bytes,
+           read_count);
+    printf("%12s %12s %16s %14s\n", "pages", "map us", "alloc+touch ns", "read ns");
+
+    run("base", 0u);
+    run("huge", KOI_POOL_MAP_HUGE_PAGES);
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures a producer thread allocating messages that consumer threads free, handed over through 1 single-producer
+ * single-consumer ring per consumer. Compares the remote free pool against a koi_pool_t behind a single mutex, which
+ * both sides have to take for every message.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/remote_free_pool.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+static const size_t message_size = 64u;
+static const size_t message_count = 4000000u;
+static const size_t ring_size = 1024u;
+static const size_t pool_bytes = 64u * 1024u * 1024u;
+
+
+/**
+ * A bounded queue between 1 producer and 1 consumer.
+ */
+struct Ring {
+    void* slots[ring_size];
+    alignas(64) std::atomic<size_t> head{0u};
+    alignas(64) std::atomic<size_t> tail{0u};
+
+    void push(void* ptr) {
+        size_t tail_index = tail.load(std::memory_order_relaxed);
+        while (tail_index - head.load(std::memory_order_acquire) == ring_size) {
+            std::this_thread::yield();
+        }
+
+        slots[tail_index % ring_size] = ptr;
+        tail.store(tail_index + 1u, std::memory_order_release);
+    }
+
+    void* pop() {
+        size_t head_index = head.load(std::memory_order_relaxed);
+        while (tail.load(std::memory_order_acquire) == head_index) {
+            std::this_thread::yield();
+        }
+
+        void* ptr = slots[head_index % ring_size];
+        head.store(head_index + 1u, std::memory_order_release);
+        return ptr;
+    }
+};
+
+
+/**
+ * Sends message_count messages round robin to the given number of consumers.
+ * @return Millions of messages per second, or a negative number if an allocation failed.
+ */
+template<typename Alloc, typename Free>
+static double run(size_t consumer_count, Alloc alloc, Free free) {
+    std::vector<Ring> rings(consumer_count);
+    std::vector<std::thread> consumers;
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t c = 0u; c < consumer_count; ++c) {
+        consumers.emplace_back([&rings, &free, c, consumer_count]() {
+            for (size_t i = c; i < message_count; i += consumer_count) {
+                void* message = rings[c].pop();
+                KoiBenchmark::do_not_optimize(message);
+                free(message);
+            }
+        });
+    }
+
+    bool failed = false;
+    for (size_t i = 0u; i < message_count; ++i) {
+        void* message = alloc(message_size);
+        failed |= message == nullptr;
+        rings[i % consumer_count].push(message);
+    }
+
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+
+    if (failed) {
+        return -1.0;
+    }
+
+    return (double)message_count * 1000.0 / (double)(KoiBenchmark::now_ns() - begin);
+}
+
+
+int main() {
+    std::vector<char> buffer(pool_bytes);
+    // 1 hardware thread is left for the producer
+    size_t hardware_threads = std::thread::hardware_concurrency();
+    size_t max_consumers = hardware_threads > 2u ? hardware_threads - 1u : 1u;
+
+    printf("%zu messages of %zu bytes, M messages/s\n", message_count, message_size);
+    printf("%10s %14s %14s\n", "consumers", "remote free", "mutex");
+
+    for (size_t consumer_count = 1u; consumer_count <= max_consumers; consumer_count *= 2u) {
+        Koi::RemoteFreePool remote_free_pool;
+        remote_free_pool.init(buffer.data(), buffer.size());
+
+        double remote_free = run(consumer_count, [&remote_free_pool](size_t size) {
+            return remote_free_pool.alloc(size);
+        }, [&remote_free_pool](void* ptr) {
+            remote_free_pool.free(ptr);
+        });
+
+        koi_pool_t pool;
+        koi_pool_init(&pool, buffer.data(), buffer.size());
+        std::mutex mutex;
+
+        double locked = run(consumer_count, [&pool, &mutex](size_t size) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return koi_pool_alloc(&pool, size);
+        }, [&pool, &mutex](void* ptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            koi_pool_free(&pool, ptr);
+        });
+
+        printf("%10zu %14.2f %14.2f\n", consumer_count, remote_free, locked);
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures how alloc/free throughput scales with threads, from 1 thread to 1 per hardware thread. Each thread churns
+ * its own live allocations. Compares a sharded pool with 1 shard per hardware thread against the same pool with 1
+ * shard, which is a single koi_pool_t behind a single mutex.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/sharded_pool.hpp"
+
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+static const size_t live_count = 256u;
+static const size_t operations_per_thread = 1000000u;
+static const size_t pool_bytes = 256u * 1024u * 1024u;
+
+
+/**
+ * Runs the churn on thread_count threads at once.
+ * @return Millions of alloc/free pairs per second over all threads, or a negative number if an allocation failed.
+ */
+static double run(Koi::ShardedPool& pool, size_t thread_count) {
+    std::vector<std::thread> threads;
+    std::vector<int> failed(thread_count, 0);
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t t = 0u; t < thread_count; ++t) {
+        threads.emplace_back([&pool, &failed, t]() {
+            std::mt19937 random((unsigned)t);
+            std::uniform_int_distribution<size_t> pick_size(16u, 512u);
+            std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+            std::vector<void*> live(live_count, nullptr);
+
+            for (size_t i = 0u; i < operations_per_thread; ++i) {
+                size_t slot = pick_slot(random);
+                pool.free(live[slot]);
+                live[slot] = pool.alloc(pick_size(random));
+                failed[t] |= live[slot] == nullptr;
+            }
+
+            for (void* ptr : live) {
+                pool.free(ptr);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    uint64_t elapsed_ns = KoiBenchmark::now_ns() - begin;
+
+    for (int f : failed) {
+        if (f != 0) {
+            return -1.0;
+        }
+    }
+
+    return (double)(thread_count * operations_per_thread) * 1000.0 / (double)elapsed_ns;
+}
+
+
+int main() {
+    std::vector<char> buffer(pool_bytes);
+    size_t hardware_threads = std::thread::hardware_concurrency();
+    hardware_threads = hardware_threads == 0u ? 1u : hardware_threads;
+
+    printf("%zu alloc/free pairs per thread over %zu live allocations, M pairs/s\n", operations_per_thread,
+           live_count);
+    printf("%10s %14s %14s\n", "threads", "sharded", "1 shard");
+
+    // powers of 2, then every hardware thread if that isn't one
+    for (size_t thread_count = 1u; ; thread_count *= 2u) {
+        if (thread_count > hardware_threads) {
+            thread_count = hardware_threads;
+        }
+
+        Koi::ShardedPool sharded_pool;
+        sharded_pool.init(buffer.data(), buffer.size());
+        double sharded = run(sharded_pool, thread_count);
+
+        Koi::ShardedPool single_pool;
+        single_pool.init(buffer.data(), buffer.size(), 1u);
+        double single = run(single_pool, thread_count);
+
+        printf("%10zu %14.2f %14.2f\n", thread_count, sharded, single);
+
+        if (thread_count == hardware_threads) {
+            break;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures alloc/free throughput of small allocations that churn, comparing koi_static_alloc/koi_static_free against
+ * libc malloc/free. Each operation frees a random live allocation and allocates a new one of a random size in place of
+ * it. Build with KOI_SIZE_CLASS_MAX_SIZE=0u to measure the free list alone.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+static const size_t min_size = 16u;
+static const size_t max_size = 256u;
+static const size_t live_count = 4096u;
+static const size_t operation_count = 1000000u;
+
+
+/**
+ * Runs the churn workload with the given functions.
+ * @return Millions of alloc/free pairs per second, or a negative number if an allocation failed.
+ */
+template<typename Alloc, typename Free>
+static double churn(Alloc alloc, Free free) {
+    std::mt19937 random(7u);
+    std::uniform_int_distribution<size_t> pick_size(min_size, max_size);
+    std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+
+    // generate the workload up front so only the allocator is timed
+    std::vector<size_t> sizes(operation_count);
+    std::vector<size_t> slots(operation_count);
+    for (size_t i = 0u; i < operation_count; ++i) {
+        sizes[i] = pick_size(random);
+        slots[i] = pick_slot(random);
+    }
+
+    std::vector<void*> live(live_count);
+    for (size_t i = 0u; i < live_count; ++i) {
+        live[i] = alloc(pick_size(random));
+    }
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t i = 0u; i < operation_count; ++i) {
+        free(live[slots[i]]);
+        live[slots[i]] = alloc(sizes[i]);
+
+        if (live[slots[i]] == nullptr) {
+            return -1.0;
+        }
+    }
+    uint64_t elapsed_ns = KoiBenchmark::now_ns() - begin;
+
+    for (size_t i = 0u; i < live_count; ++i) {
+        free(live[i]);
+    }
+
+    return (double)operation_count * 1000.0 / (double)elapsed_ns;
+}
+
+
+int main() {
+    printf("%zu-%zu byte churn over %zu live allocations, size classes up to %zu bytes\n",
+           min_size, max_size, live_count, (size_t)KOI_SIZE_CLASS_MAX_SIZE);
+    printf("%16s %24s\n", "allocator", "M alloc/free per second");
+
+    koi_static_init();
+    double koi_static = churn(
+            [](size_t size) { return koi_static_alloc(size); },
+            [](void* ptr) { koi_static_free(ptr); }
+    );
+
+    double libc = churn(
+            [](size_t size) { return malloc(size); },
+            [](void* ptr) { free(ptr); }
+    );
+
+    printf("%16s %24.2f\n", "koi_static", koi_static);
+    printf("%16s %24.2f\n", "malloc", libc);
+
+    return koi_static < 0.0 ? 1 : 0;
+}
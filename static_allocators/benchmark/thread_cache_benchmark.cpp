@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures how alloc/free throughput scales from 1 thread to 1 thread per hardware thread. Each thread churns 16-256
+ * byte allocations: it frees a random live allocation and allocates a new one in place of it. Compares the thread cached
+ * pool against a koi_pool_t behind a single mutex and against libc malloc.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/thread_cached_pool.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+static const size_t min_size = 16u;
+static const size_t max_size = 256u;
+static const size_t live_count = 256u;
+static const size_t operations_per_thread = 500000u;
+static const size_t pool_bytes = 64u * 1024u * 1024u;
+
+
+/**
+ * Runs the churn workload on the given number of threads with the given functions.
+ * @return Millions of alloc/free pairs per second across all threads, or a negative number if an allocation failed.
+ */
+template<typename Alloc, typename Free>
+static double churn(size_t thread_count, Alloc alloc, Free free) {
+    std::vector<std::thread> threads;
+    std::vector<int> failed(thread_count, 0);
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t t = 0u; t < thread_count; ++t) {
+        threads.emplace_back([t, &failed, &alloc, &free]() {
+            std::mt19937 random((unsigned)t);
+            std::uniform_int_distribution<size_t> pick_size(min_size, max_size);
+            std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+            std::vector<void*> live(live_count, nullptr);
+
+            for (size_t i = 0u; i < operations_per_thread; ++i) {
+                size_t slot = pick_slot(random);
+
+                free(live[slot]);
+                live[slot] = alloc(pick_size(random));
+                failed[t] |= live[slot] == nullptr;
+            }
+
+            for (void* ptr : live) {
+                free(ptr);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    uint64_t elapsed_ns = KoiBenchmark::now_ns() - begin;
+
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end()) {
+        return -1.0;
+    }
+
+    return (double)(thread_count * operations_per_thread) * 1000.0 / (double)elapsed_ns;
+}
+
+
+int main() {
+    size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<char> cached_buffer(pool_bytes);
+    std::vector<char> locked_buffer(pool_bytes);
+    int result = 0;
+
+    printf("%zu-%zu byte churn, %zu live allocations per thread, M alloc/free per second\n",
+           min_size, max_size, live_count);
+    printf("%8s %20s %20s %20s\n", "threads", "thread cached pool", "mutex + koi_pool", "malloc");
+
+    for (size_t thread_count = 1u; thread_count <= max_threads; ++thread_count) {
+        Koi::ThreadCachedPool cached_pool;
+        cached_pool.init(cached_buffer.data(), cached_buffer.size());
+
+        koi_pool_t locked_pool;
+        std::mutex mutex;
+        koi_pool_init(&locked_pool, locked_buffer.data(), locked_buffer.size());
+
+        double cached = churn(
+                thread_count,
+                [&cached_pool](size_t size) { return cached_pool.alloc(size); },
+                [&cached_pool](void* ptr) { cached_pool.free(ptr); }
+        );
+
+        double locked = churn(
+                thread_count,
+                [&locked_pool, &mutex](size_t size) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return koi_pool_alloc(&locked_pool, size);
+                },
+                [&locked_pool, &mutex](void* ptr) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    koi_pool_free(&locked_pool, ptr);
+                }
+        );
+
+        double libc = churn(
+                thread_count,
+                [](size_t size) { return malloc(size); },
+                [](void* ptr) { free(ptr); }
+        );
+
+        printf("%8zu %20.2f %20.2f %20.2f\n", thread_count, cached, locked, libc);
+
+        if (cached < 0.0 || locked < 0.0) {
+            result = 1;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Records a trace of a synthetic workload through the static memory pool, for trying out trace_replay without a
+ * production trace. A production build records its own by building with KOI_POOL_TRACE=1 and passing a
+ * Koi::TraceWriter to koi_static_set_trace or koi_pool_set_trace.
+ * Usage: trace_capture [trace file, default koi_trace.bin]
+ */
+
+
+#include "static_allocators/allocator.h"
+#include "static_allocators/trace.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+static const size_t live_count = 4096u;
+static const size_t operation_count = 1000000u;
+
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : "koi_trace.bin";
+
+    koi_static_init();
+
+    Koi::TraceWriter writer;
+    if (!writer.open(path)) {
+        printf("couldn't create %s\n", path);
+        return 1;
+    }
+
+    koi_static_set_trace(Koi::TraceWriter::callback, &writer);
+
+    // mostly small, short-lived objects, some medium buffers that grow, and a few large ones
+    std::mt19937 random(11u);
+    std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+    std::uniform_int_distribution<size_t> pick_kind(0u, 99u);
+    std::vector<void*> live(live_count, nullptr);
+
+    for (size_t i = 0u; i < operation_count; ++i) {
+        size_t slot = pick_slot(random);
+        size_t kind = pick_kind(random);
+
+        if (kind < 85u) {
+            koi_static_free(live[slot]);
+            live[slot] = koi_static_alloc(std::uniform_int_distribution<size_t>(8u, 256u)(random));
+        } else if (kind < 99u) {
+            size_t size = live[slot] == nullptr ? 512u : 2u * std::uniform_int_distribution<size_t>(256u, 4096u)(random);
+            void* grown = koi_static_realloc(live[slot], size);
+            if (grown != nullptr) {
+                live[slot] = grown;
+            }
+        } else {
+            koi_static_free(live[slot]);
+            live[slot] = koi_static_alloc(std::uniform_int_distribution<size_t>(16384u, 262144u)(random));
+        }
+    }
+
+    for (void* ptr : live) {
+        koi_static_free(ptr);
+    }
+
+    koi_static_set_trace(nullptr, nullptr);
+    writer.close();
+
+    printf("wrote %zu operations to %s\n", operation_count, path);
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Replays a trace written by Koi::TraceWriter against each allocator strategy and malloc, as fast as possible, and
+ * reports the time spent in alloc and free, the peak footprint and the number of failed allocations. The footprint of
+ * a pool is the furthest byte from the start of its memory that an allocation ever reached. For malloc, whose memory
+ * isn't visible, only the peak of the bytes requested is known, which every strategy's footprint is compared against.
+ * Usage: trace_replay <trace file> [pool MB, default 64]
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+#include "static_allocators/buddy_allocator.h"
+#include "static_allocators/tlsf_allocator.h"
+#include "static_allocators/trace.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+/**
+ * Replays the records with the given functions and prints the results.
+ * @param memory The start of the allocator's memory, or nullptr if its footprint can't be measured.
+ */
+template<typename Alloc, typename Free>
+static void replay(const char* name, const std::vector<Koi::TraceRecord>& records, const char* memory,
+                   Alloc alloc, Free free) {
+    std::vector<void*> live;
+    size_t failures = 0u;
+    size_t footprint = 0u;
+    uint64_t elapsed_ns = 0u;
+
+    for (const Koi::TraceRecord& record : records) {
+        if (record.id >= live.size()) {
+            live.resize(record.id + 1u, nullptr);
+        }
+
+        // frees of allocations made before the trace started, or that failed, are skipped
+        if (record.size == 0u) {
+            if (live[record.id] != nullptr) {
+                uint64_t begin = KoiBenchmark::now_ns();
+                free(live[record.id]);
+                elapsed_ns += KoiBenchmark::now_ns() - begin;
+                live[record.id] = nullptr;
+            }
+
+            continue;
+        }
+
+        uint64_t begin = KoiBenchmark::now_ns();
+        void* ptr = alloc(record.size);
+        elapsed_ns += KoiBenchmark::now_ns() - begin;
+
+        live[record.id] = ptr;
+
+        if (ptr == nullptr) {
+            ++failures;
+        } else if (memory != nullptr && (size_t)((char*)ptr - memory) + record.size > footprint) {
+            footprint = (size_t)((char*)ptr - memory) + record.size;
+        }
+    }
+
+    for (void* ptr : live) {
+        if (ptr != nullptr) {
+            free(ptr);
+        }
+    }
+
+    if (memory != nullptr) {
+        printf("%-12s %12.2f %16.1f %10zu\n", name, (double)elapsed_ns / 1e6, (double)footprint / 1024.0, failures);
+    } else {
+        printf("%-12s %12.2f %16s %10zu\n", name, (double)elapsed_ns / 1e6, "-", failures);
+    }
+}
+
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("usage: %s <trace file> [pool MB, default 64]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Koi::TraceRecord> records;
+    if (!Koi::read_trace(argv[1], records)) {
+        printf("couldn't read the trace %s\n", argv[1]);
+        return 1;
+    }
+
+    size_t pool_bytes = (argc > 2 ? (size_t)strtoul(argv[2], nullptr, 10) : 64u) * 1024u * 1024u;
+
+    // the peak of the bytes live at once, which no strategy can go below
+    std::vector<size_t> sizes;
+    size_t live_bytes = 0u;
+    size_t peak_live_bytes = 0u;
+    for (const Koi::TraceRecord& record : records) {
+        if (record.id >= sizes.size()) {
+            sizes.resize(record.id + 1u, 0u);
+        }
+
+        live_bytes = live_bytes - sizes[record.id] + record.size;
+        sizes[record.id] = record.size;
+
+        if (live_bytes > peak_live_bytes) {
+            peak_live_bytes = live_bytes;
+        }
+    }
+
+    printf("%zu records, peak of %.1f KB requested at once, pools of %zu MB\n",
+           records.size(), (double)peak_live_bytes / 1024.0, pool_bytes / (1024u * 1024u));
+    printf("%-12s %12s %16s %10s\n", "allocator", "ms", "footprint KB", "failures");
+
+    std::vector<char> buffer(pool_bytes);
+
+    koi_pool_t pool;
+    koi_pool_init(&pool, buffer.data(), buffer.size());
+    replay(
+            "koi_pool", records, buffer.data(),
+            [&pool](size_t size) { return koi_pool_alloc(&pool, size); },
+            [&pool](void* ptr) { koi_pool_free(&pool, ptr); }
+    );
+
+    koi_buddy_t buddy;
+    koi_buddy_init(&buddy, buffer.data(), buffer.size());
+    replay(
+            "koi_buddy", records, buffer.data(),
+            [&buddy](size_t size) { return koi_buddy_alloc(&buddy, size); },
+            [&buddy](void* ptr) { koi_buddy_free(&buddy, ptr); }
+    );
+
+    koi_tlsf_t tlsf;
+    koi_tlsf_init(&tlsf, buffer.data(), buffer.size());
+    replay(
+            "koi_tlsf", records, buffer.data(),
+            [&tlsf](size_t size) { return koi_tlsf_alloc(&tlsf, size); },
+            [&tlsf](void* ptr) { koi_tlsf_free(&tlsf, ptr); }
+    );
+
+    replay(
+            "malloc", records, nullptr,
+            [](size_t size) { return malloc(size); },
+            [](void* ptr) { free(ptr); }
+    );
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Measures what skipping the memset saves on buffers that are overwritten right away, such as serialization output.
+ * Each operation allocates a buffer, copies a payload into it and frees it, once through koi_pool_calloc and once
+ * through koi_pool_alloc.
+ */
+
+
+#include "benchmark.hpp"
+
+#include "static_allocators/allocator.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+static const size_t bytes_per_size = 1024u * 1024u * 1024u;
+
+
+/**
+ * Allocates, fills and frees a buffer of the given size until bytes_per_size bytes were copied.
+ * @return The nanoseconds per operation.
+ */
+template<typename Alloc>
+static double run(koi_pool_t* pool, const char* payload, size_t size, Alloc alloc) {
+    size_t operation_count = bytes_per_size / size;
+
+    uint64_t begin = KoiBenchmark::now_ns();
+    for (size_t i = 0u; i < operation_count; ++i) {
+        void* ptr = alloc(pool, size);
+        memcpy(ptr, payload, size);
+        KoiBenchmark::do_not_optimize(ptr);
+        koi_pool_free(pool, ptr);
+    }
+
+    return (double)(KoiBenchmark::now_ns() - begin) / (double)operation_count;
+}
+
+
+int main() {
+    const size_t sizes[] = {4096u, 16384u, 65536u, 262144u, 1048576u};
+
+    std::vector<char> buffer(4u * 1024u * 1024u);
+    std::vector<char> payload(1048576u, 'A');
+    koi_pool_t pool;
+    koi_pool_init(&pool, buffer.data(), buffer.size());
+
+    printf("alloc, copy a payload in and free, %zu MB copied per size\n", bytes_per_size / (1024u * 1024u));
+    printf("%10s %16s %16s %12s %12s\n", "bytes", "calloc ns/op", "alloc ns/op", "calloc GB/s", "alloc GB/s");
+
+    for (size_t size : sizes) {
+        double calloc_ns = run(&pool, payload.data(), size, [](koi_pool_t* pool, size_t size) {
+            return koi_pool_calloc(pool, 1u, size);
+        });
+        double alloc_ns = run(&pool, payload.data(), size, [](koi_pool_t* pool, size_t size) {
+            return koi_pool_alloc(pool, size);
+        });
+
+        printf("%10zu %16.1f %16.1f %12.2f %12.2f\n",
+               size, calloc_ns, alloc_ns, (double)size / calloc_ns, (double)size / alloc_ns);
+    }
+
+    return 0;
+}
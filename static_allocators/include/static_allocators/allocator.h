@@ -40,30 +40,371 @@ extern "C" {
 #define KOI_MEMORY_POOL_SIZE 16u
 #endif
 
+/**
+ * The biggest allocation, in bytes, that is served by the size classes. Freed allocations up to this size are kept in
+ * a free list per size class for O(1) reuse instead of merging back into the memory pool. 0 disables the size classes.
+ * Changes the layout of koi_pool_t, so set it through SIZE_CLASS_MAX_SIZE in CMake to keep users of the library in sync.
+ */
+#ifndef KOI_SIZE_CLASS_MAX_SIZE
+#define KOI_SIZE_CLASS_MAX_SIZE 256u
+#endif
+
+/**
+ * The most bytes the size classes can hold. A free that would park past it merges its allocation back into the memory
+ * pool straight away, so the allocations already parked stay ready for reuse. Raising KOI_SIZE_CLASS_MAX_SIZE defers
+ * merging for bigger allocations too, and this bounds how much memory they keep from other sizes. 0 lets them hold any
+ * amount, merging it all only when an allocation would otherwise fail. The parked allocations still split up the free
+ * sections, so under first fit a switch to bigger allocations searches past them, and KOI_FIT_BEST avoids that. Changes
+ * the layout of koi_pool_t, so set it through SIZE_CLASS_FLUSH_THRESHOLD in CMake to keep users of the library in sync.
+ */
+#ifndef KOI_SIZE_CLASS_FLUSH_THRESHOLD
+#define KOI_SIZE_CLASS_FLUSH_THRESHOLD 0u
+#endif
+
+/**
+ * The size of the data block structure used in memory pools, which is made of 6 pointer-sized fields.
+ */
+#define KOI_BLOCK_SIZE (6u * sizeof(void*))
+
+/**
+ * The alignment of every allocation's data, which is the biggest power of 2 dividing KOI_BLOCK_SIZE. Memory pools start
+ * on this alignment, so koi_pool_alloc_aligned can reach any bigger power of 2 alignment by skipping a few blocks.
+ */
+#define KOI_POOL_ALIGNMENT (KOI_BLOCK_SIZE & (~KOI_BLOCK_SIZE + 1u))
+
+/**
+ * Whether memory pools keep the counters behind koi_pool_get_stats: the high-water mark, allocation failures and search
+ * lengths. Costs a few additions per call when 1, and nothing when 0.
+ */
+#ifndef KOI_POOL_STATS
+#define KOI_POOL_STATS 0
+#endif
+
+/**
+ * Whether memory pools can report every allocation and free to a callback set with koi_pool_set_trace, for example to
+ * record a trace with Koi::TraceWriter. Costs a branch per call when 1, and nothing when 0.
+ */
+#ifndef KOI_POOL_TRACE
+#define KOI_POOL_TRACE 0
+#endif
+
+/**
+ * The fit policies a memory pool can use to pick the free section for an allocation.
+ * KOI_FIT_FIRST: the earliest free section big enough, searched from the start of the pool.
+ * KOI_FIT_NEXT: the first free section big enough after the last allocation, searched with a roving pointer that wraps
+ * around to the start of the pool.
+ * KOI_FIT_BEST: the smallest free section big enough, and the earliest of those, found in a tree of free sections
+ * indexed by size in O(log n) expected time.
+ */
+#define KOI_FIT_FIRST 0
+#define KOI_FIT_NEXT 1
+#define KOI_FIT_BEST 2
+
+/**
+ * The fit policy of memory pools, 1 of KOI_FIT_FIRST, KOI_FIT_NEXT or KOI_FIT_BEST. Only the searches of the block
+ * chain follow it; the size classes are still tried first.
+ */
+#ifndef KOI_FIT_POLICY
+#define KOI_FIT_POLICY KOI_FIT_FIRST
+#endif
+
+/**
+ * The number of buckets in the search length histogram. Bucket i counts the searches that visited from 2^i up to
+ * 2^(i + 1) - 1 sections of the memory pool, and the last bucket also counts every longer search.
+ */
+#define KOI_POOL_STATS_SEARCH_BUCKETS 16u
+
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+/**
+ * The number of size classes. Size class i holds allocations that are i + 1 blocks big.
+ */
+#define KOI_SIZE_CLASS_COUNT ((KOI_SIZE_CLASS_MAX_SIZE + KOI_BLOCK_SIZE - 1u) / KOI_BLOCK_SIZE)
+#endif
+
+
+struct koi_block_t;
+
+#if KOI_POOL_TRACE
+/**
+ * Receives every allocation and free of a memory pool.
+ * @param user_data The pointer given to koi_pool_set_trace.
+ * @param id The allocation's id, which is unique among live allocations of the pool but reused after they're freed.
+ * @param size The number of bytes allocated, or 0 for a free.
+ */
+typedef void (*koi_trace_callback_t)(void* user_data, size_t id, size_t size);
+#endif
+
+/**
+ * A memory pool over memory supplied by its owner. Its members are managed by the koi_pool_* functions.
+ * memory: the first block of the memory pool.
+ * block_count: the number of blocks in the memory pool.
+ * free_list: the earliest free block in the memory pool, or NULL if it is full.
+ * size_classes: singly-linked lists of freed small allocations, one per size class.
+ * size_class_blocks: the blocks parked in the size classes, when KOI_SIZE_CLASS_FLUSH_THRESHOLD is set.
+ * rover: the block the next search starts at, when KOI_FIT_POLICY is KOI_FIT_NEXT.
+ * free_tree: the root of the tree of free sections, when KOI_FIT_POLICY is KOI_FIT_BEST.
+ * bytes_held, high_water_mark, failure_count, search_lengths: the counters behind koi_pool_get_stats. bytes_held counts
+ * the blocks parked in the size classes as well as live allocations.
+ * trace, trace_user_data: the callback set with koi_pool_set_trace and its argument.
+ */
+typedef struct koi_pool_t {
+    struct koi_block_t* memory;
+    size_t block_count;
+    struct koi_block_t* free_list;
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+    struct koi_block_t* size_classes[KOI_SIZE_CLASS_COUNT];
+#if KOI_SIZE_CLASS_FLUSH_THRESHOLD > 0u
+    size_t size_class_blocks;
+#endif
+#endif
+#if KOI_FIT_POLICY == KOI_FIT_NEXT
+    struct koi_block_t* rover;
+#elif KOI_FIT_POLICY == KOI_FIT_BEST
+    struct koi_block_t* free_tree;
+#endif
+#if KOI_POOL_STATS
+    size_t bytes_held;
+    size_t high_water_mark;
+    size_t failure_count;
+    size_t search_lengths[KOI_POOL_STATS_SEARCH_BUCKETS];
+#endif
+#if KOI_POOL_TRACE
+    koi_trace_callback_t trace;
+    void* trace_user_data;
+#endif
+} koi_pool_t;
+
+/**
+ * A snapshot of a memory pool's usage. Sizes are in bytes of data, not counting the blocks that manage allocations.
+ * bytes_in_use: the bytes of live allocations, rounded up to whole blocks.
+ * high_water_mark: the most bytes live allocations and the size classes have held at once, which is the most memory the
+ * pool has needed. 0 unless KOI_POOL_STATS is 1.
+ * free_bytes: the bytes in free sections of the memory pool.
+ * free_segments: the number of free sections.
+ * largest_free_segment: the bytes in the biggest free section, which is the biggest allocation that can succeed.
+ * size_class_bytes: the bytes of freed small allocations parked in the size classes, which only same-sized allocations
+ * reuse until they are flushed.
+ * fragmentation: the external fragmentation, 1 - largest_free_segment / free_bytes. 0 when all free memory is in 1
+ * section, approaching 1 as it is split into many small sections.
+ * failure_count: the number of allocations that failed for lack of memory. 0 unless KOI_POOL_STATS is 1.
+ * search_lengths: a histogram of the number of sections visited per search of the block chain, see
+ * KOI_POOL_STATS_SEARCH_BUCKETS. All 0 unless KOI_POOL_STATS is 1.
+ */
+typedef struct koi_pool_stats_t {
+    size_t bytes_in_use;
+    size_t high_water_mark;
+    size_t free_bytes;
+    size_t free_segments;
+    size_t largest_free_segment;
+    size_t size_class_bytes;
+    double fragmentation;
+    size_t failure_count;
+    size_t search_lengths[KOI_POOL_STATS_SEARCH_BUCKETS];
+} koi_pool_stats_t;
+
+
 /**
  * Gets the size of the data block structure used in the static heap.
  */
 extern size_t koi_static_get_block_size(void);
 
 /**
- * Initializes the static memory pool for use.
+ * Initializes a memory pool to manage the given memory. The memory must outlive the pool's use.
+ * @param pool The memory pool to initialize.
+ * @param buffer The memory to allocate from. Doesn't need to be aligned, but bytes before the first KOI_POOL_ALIGNMENT
+ * aligned byte are skipped.
+ * @param bytes The number of bytes in buffer.
+ * @return 1 if successful, or 0 if the buffer is too small to hold a single allocation.
+ */
+extern int koi_pool_init(koi_pool_t* pool, void* buffer, size_t bytes);
+
+/**
+ * Allocates the number of bytes from the memory pool, if enough exists. The bytes aren't zeroed, see koi_pool_calloc.
+ * @param pool The memory pool to allocate from.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate.
+ */
+extern void* koi_pool_alloc(koi_pool_t* pool, size_t size);
+
+/**
+ * Allocates zeroed memory for the number of elements of the given size from the memory pool, if enough exists.
+ * @param pool The memory pool to allocate from.
+ * @param count The number of elements to allocate.
+ * @param size The number of bytes per element. If it or count is 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate or count * size overflows.
+ */
+extern void* koi_pool_calloc(koi_pool_t* pool, size_t count, size_t size);
+
+/**
+ * Allocates the number of bytes from the memory pool with its first byte aligned to the given alignment, if enough
+ * exists. The bytes aren't zeroed. The blocks skipped to reach the alignment stay free, so at most alignment / KOI_POOL_ALIGNMENT - 1 blocks
+ * are kept from use, and only while the allocation is live. Free it with koi_pool_free.
+ * @param pool The memory pool to allocate from.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @param alignment The alignment of the first byte. Must be a power of 2.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate or alignment isn't a power
+ * of 2.
+ */
+extern void* koi_pool_alloc_aligned(koi_pool_t* pool, size_t size, size_t alignment);
+
+/**
+ * Frees the memory allocated from the memory pool starting at the given pointer. Runs in constant time regardless of
+ * the number of live allocations.
+ * @param pool The memory pool the memory was allocated from.
+ * @param ptr The pointer at the first byte of allocated memory that needs to be freed. If NULL, or not a pointer returned
+ * by koi_pool_alloc for this pool, does nothing.
+ * @return NULL.
+ */
+extern void* koi_pool_free(koi_pool_t* pool, void* ptr);
+
+/**
+ * Allocates the number of allocations of the same size from 1 contiguous section of the memory pool, which is found
+ * with a single search and split into the allocations in 1 pass. The bytes aren't zeroed. Free them with
+ * koi_pool_free or koi_pool_free_batch.
+ * @param pool The memory pool to allocate from.
+ * @param size The number of bytes per allocation. If 0, does nothing.
+ * @param count The number of allocations. If 0, does nothing.
+ * @param out_ptrs The array of count pointers to set to the allocations, in address order.
+ * @return 1 if successful, or 0 if no section was big enough for all of the allocations, in which case nothing is
+ * allocated and out_ptrs is left untouched.
+ */
+extern int koi_pool_alloc_batch(koi_pool_t* pool, size_t size, size_t count, void** out_ptrs);
+
+/**
+ * Frees the memory allocated from the memory pool starting at each of the given pointers. The pointers are sorted by
+ * address, then each run of allocations next to each other is merged with its free neighbours at once. Unlike
+ * koi_pool_free, small allocations merge back into the pool rather than being kept by their size class.
+ * @param pool The memory pool the memory was allocated from.
+ * @param ptrs The array of count pointers to free, which is sorted in place. Pointers that are NULL, repeated, or not
+ * returned by koi_pool_alloc for this pool are skipped.
+ * @param count The number of pointers.
+ */
+extern void koi_pool_free_batch(koi_pool_t* pool, void** ptrs, size_t count);
+
+/**
+ * Resizes the allocation at the given pointer. Grows in place when the following section of the memory pool is free and
+ * big enough, shrinks in place by freeing the blocks it no longer needs, and only otherwise moves the allocation to a
+ * new section, copying its bytes. Bytes past the old size aren't guaranteed to be zeroed. A moved allocation only
+ * keeps KOI_POOL_ALIGNMENT.
+ * @param pool The memory pool the memory was allocated from.
+ * @param ptr The pointer at the first byte of allocated memory. If NULL, allocates like koi_pool_alloc.
+ * @param size The new number of bytes. If 0, frees ptr like koi_pool_free.
+ * @return A pointer to the first byte of the resized allocation, or NULL if size is 0, ptr isn't a pointer returned by
+ * koi_pool_alloc for this pool, or there wasn't enough memory, in which case ptr is left untouched.
+ */
+extern void* koi_pool_realloc(koi_pool_t* pool, void* ptr, size_t size);
+
+/**
+ * Gets the number of bytes usable at the given pointer, which is its allocation's size rounded up to whole blocks.
+ * Only reads the allocation's own block, so it is safe to call while another thread allocates from or frees to the
+ * pool as long as the allocation stays live.
+ * @param pool The memory pool the memory was allocated from.
+ * @param ptr The pointer at the first byte of allocated memory.
+ * @return The number of bytes, or 0 if ptr isn't a pointer returned by koi_pool_alloc for this pool.
+ */
+extern size_t koi_pool_get_size(const koi_pool_t* pool, void* ptr);
+
+/**
+ * Gets a snapshot of the memory pool's usage. Walks the whole block chain, so it runs in linear time in the number of
+ * sections and is meant for occasional sampling rather than every allocation.
+ * @param pool The memory pool to inspect.
+ * @param stats The snapshot to fill.
+ */
+extern void koi_pool_get_stats(const koi_pool_t* pool, koi_pool_stats_t* stats);
+
+#if KOI_POOL_TRACE
+/**
+ * Sets the callback that receives every allocation and free of the memory pool from now on. Resizing an allocation is
+ * reported as a free followed by an allocation.
+ * @param pool The memory pool to trace.
+ * @param callback The callback, or NULL to stop tracing.
+ * @param user_data The pointer passed to every call of callback.
+ */
+extern void koi_pool_set_trace(koi_pool_t* pool, koi_trace_callback_t callback, void* user_data);
+#endif
+
+/**
+ * Initializes the static memory pool for use. The static memory pool is the default instance of koi_pool_t, holding
+ * KOI_MEMORY_POOL_SIZE blocks.
  */
 extern void koi_static_init(void);
 
 /**
- * Allocates the number of bytes to the memory pool, if enough exists.
+ * Allocates the number of bytes to the memory pool, if enough exists. The bytes aren't zeroed, see koi_static_calloc.
  * @param size The number of bytes to allocate. If 0, does nothing.
  * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate.
  */
 extern void* koi_static_alloc(size_t size);
 
 /**
- * Frees the memory allocated starting at the given pointer.
- * @param ptr The pointer at the first byte of allocated memory that needs to be freed. If NULL, does nothing.
+ * Allocates zeroed memory for the number of elements of the given size to the memory pool, if enough exists.
+ * @param count The number of elements to allocate.
+ * @param size The number of bytes per element. If it or count is 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate or count * size overflows.
+ */
+extern void* koi_static_calloc(size_t count, size_t size);
+
+/**
+ * Allocates the number of bytes to the memory pool with its first byte aligned to the given alignment, if enough
+ * exists. The bytes aren't zeroed. Free it with koi_static_free.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @param alignment The alignment of the first byte. Must be a power of 2.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate or alignment isn't a power
+ * of 2.
+ */
+extern void* koi_static_alloc_aligned(size_t size, size_t alignment);
+
+/**
+ * Resizes the allocation at the given pointer, in place if possible. See koi_pool_realloc.
+ * @param ptr The pointer at the first byte of allocated memory. If NULL, allocates like koi_static_alloc.
+ * @param size The new number of bytes. If 0, frees ptr like koi_static_free.
+ * @return A pointer to the first byte of the resized allocation, or NULL if size is 0, ptr isn't a pointer returned by
+ * koi_static_alloc, or there wasn't enough memory, in which case ptr is left untouched.
+ */
+extern void* koi_static_realloc(void* ptr, size_t size);
+
+/**
+ * Frees the memory allocated starting at the given pointer. Runs in constant time regardless of the number of live
+ * allocations.
+ * @param ptr The pointer at the first byte of allocated memory that needs to be freed. If NULL, or not a pointer returned
+ * by koi_static_alloc, does nothing.
  * @return NULL.
  */
 extern void* koi_static_free(void* ptr);
 
+/**
+ * Allocates the number of allocations of the same size from 1 contiguous section of the static memory pool. See
+ * koi_pool_alloc_batch.
+ * @param size The number of bytes per allocation. If 0, does nothing.
+ * @param count The number of allocations. If 0, does nothing.
+ * @param out_ptrs The array of count pointers to set to the allocations, in address order.
+ * @return 1 if successful, or 0 if there wasn't enough contiguous memory, in which case nothing is allocated.
+ */
+extern int koi_static_alloc_batch(size_t size, size_t count, void** out_ptrs);
+
+/**
+ * Frees the memory allocated starting at each of the given pointers, merging neighbours in 1 sorted pass. See
+ * koi_pool_free_batch.
+ * @param ptrs The array of count pointers to free, which is sorted in place.
+ * @param count The number of pointers.
+ */
+extern void koi_static_free_batch(void** ptrs, size_t count);
+
+#if KOI_POOL_TRACE
+/**
+ * Sets the callback that receives every allocation and free of the static memory pool. See koi_pool_set_trace.
+ * @param callback The callback, or NULL to stop tracing.
+ * @param user_data The pointer passed to every call of callback.
+ */
+extern void koi_static_set_trace(koi_trace_callback_t callback, void* user_data);
+#endif
+
+/**
+ * Gets a snapshot of the static memory pool's usage. See koi_pool_get_stats.
+ * @param stats The snapshot to fill.
+ */
+extern void koi_static_get_stats(koi_pool_stats_t* stats);
+
 #ifdef __cplusplus
 };
 #endif
@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_ARENA_ALLOCATOR_H
+#define STATIC_ALLOCATORS_ARENA_ALLOCATOR_H
+
+
+
+
+#ifdef __cplusplus
+#include <cstdlib>
+extern "C" {
+#else
+#include <stdlib.h>
+#endif
+
+/**
+ * The alignment of allocations from koi_arena_alloc, enough for any fundamental type on common platforms.
+ */
+#ifndef KOI_ARENA_DEFAULT_ALIGNMENT
+#define KOI_ARENA_DEFAULT_ALIGNMENT (2u * sizeof(void*))
+#endif
+
+
+/**
+ * A linear arena over memory supplied by its owner. Its members are managed by the koi_arena_* functions.
+ * Allocations bump an offset and are never freed individually. They are released all at once by rewinding to a marker
+ * or resetting the arena.
+ * memory: the first byte of the arena.
+ * capacity: the number of bytes in the arena.
+ * offset: the number of bytes in use, from the start of the arena.
+ */
+typedef struct koi_arena_t {
+    char* memory;
+    size_t capacity;
+    size_t offset;
+} koi_arena_t;
+
+/**
+ * A point in an arena's allocations that it can be rewound to.
+ */
+typedef size_t koi_arena_marker_t;
+
+
+/**
+ * Initializes an arena to allocate from the given memory. The memory must outlive the arena's use.
+ * @param arena The arena to initialize.
+ * @param buffer The memory to allocate from.
+ * @param bytes The number of bytes in buffer.
+ * @return 1 if successful, or 0 if the arguments are invalid.
+ */
+extern int koi_arena_init(koi_arena_t* arena, void* buffer, size_t bytes);
+
+/**
+ * Allocates the number of bytes, aligned to KOI_ARENA_DEFAULT_ALIGNMENT, from the arena. The bytes aren't zeroed, see
+ * koi_arena_calloc.
+ * @param arena The arena to allocate from.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if the arena doesn't have enough space left.
+ */
+extern void* koi_arena_alloc(koi_arena_t* arena, size_t size);
+
+/**
+ * Allocates zeroed memory for the number of elements of the given size, aligned to KOI_ARENA_DEFAULT_ALIGNMENT, from the
+ * arena.
+ * @param arena The arena to allocate from.
+ * @param count The number of elements to allocate.
+ * @param size The number of bytes per element. If it or count is 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if the arena doesn't have enough space left or
+ * count * size overflows.
+ */
+extern void* koi_arena_calloc(koi_arena_t* arena, size_t count, size_t size);
+
+/**
+ * Allocates the number of bytes, not zeroed and aligned to the given alignment, from the arena.
+ * @param arena The arena to allocate from.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @param alignment The alignment of the first byte. Must be a power of 2.
+ * @return A pointer to the first byte in memory if successful, or NULL if the arena doesn't have enough space left or
+ * the alignment isn't a power of 2.
+ */
+extern void* koi_arena_alloc_aligned(koi_arena_t* arena, size_t size, size_t alignment);
+
+/**
+ * Gets a marker for the arena's current allocations.
+ */
+extern koi_arena_marker_t koi_arena_mark(const koi_arena_t* arena);
+
+/**
+ * Frees every allocation made since the given marker was taken, in constant time.
+ * @param arena The arena to rewind.
+ * @param marker A marker from koi_arena_mark for this arena. If it is ahead of the arena's allocations, does nothing.
+ */
+extern void koi_arena_rewind_to_mark(koi_arena_t* arena, koi_arena_marker_t marker);
+
+/**
+ * Frees every allocation in the arena, in constant time.
+ */
+extern void koi_arena_reset(koi_arena_t* arena);
+
+#ifdef __cplusplus
+};
+#endif
+
+
+#endif //STATIC_ALLOCATORS_ARENA_ALLOCATOR_H
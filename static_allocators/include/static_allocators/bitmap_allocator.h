@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_BITMAP_ALLOCATOR_H
+#define STATIC_ALLOCATORS_BITMAP_ALLOCATOR_H
+
+
+
+
+#ifdef __cplusplus
+#include <cstdlib>
+extern "C" {
+#else
+#include <stdlib.h>
+#endif
+
+/**
+ * The size in bytes of the units a bitmap allocator hands out, which is also the alignment of every allocation. Must
+ * be a power of 2.
+ */
+#ifndef KOI_BITMAP_UNIT_SIZE
+#define KOI_BITMAP_UNIT_SIZE 16u
+#endif
+
+
+/**
+ * An allocator over memory supplied by its owner that keeps all of its metadata in 2 bitmaps, away from the
+ * allocations. Its members are managed by the koi_bitmap_* functions.
+ * Allocations are runs of whole units laid out back to back with no headers between them. Free runs are found by
+ * scanning the bitmaps a word at a time.
+ * memory: the first unit.
+ * unit_count: the number of units.
+ * used_bits: a bit per unit, set if the unit is allocated.
+ * end_bits: a bit per unit, set if the unit is the last of its allocation, which is how an allocation's size is known.
+ * search_start: no unit before this one is free.
+ */
+typedef struct koi_bitmap_t {
+    char* memory;
+    size_t unit_count;
+    size_t* used_bits;
+    size_t* end_bits;
+    size_t search_start;
+} koi_bitmap_t;
+
+
+/**
+ * Initializes a bitmap allocator to manage the given memory. Its bitmaps are kept at the front of the memory, which
+ * must outlive the allocator's use.
+ * @param bitmap The bitmap allocator to initialize.
+ * @param buffer The memory to allocate from. Doesn't need to be aligned.
+ * @param bytes The number of bytes in buffer.
+ * @return 1 if successful, or 0 if the buffer is too small to hold a single unit.
+ */
+extern int koi_bitmap_init(koi_bitmap_t* bitmap, void* buffer, size_t bytes);
+
+/**
+ * Allocates the number of bytes, rounded up to whole units and not zeroed, using the first run of free units big
+ * enough. Runs in linear time in the number of bitmap words scanned.
+ * @param bitmap The bitmap allocator to allocate from.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate.
+ */
+extern void* koi_bitmap_alloc(koi_bitmap_t* bitmap, size_t size);
+
+/**
+ * Frees the memory allocated starting at the given pointer. Runs in linear time in the number of bitmap words the
+ * allocation spans.
+ * @param bitmap The bitmap allocator the memory was allocated from.
+ * @param ptr The pointer at the first byte of allocated memory that needs to be freed. If NULL, or not a pointer returned
+ * by koi_bitmap_alloc for this allocator, does nothing.
+ * @return NULL.
+ */
+extern void* koi_bitmap_free(koi_bitmap_t* bitmap, void* ptr);
+
+/**
+ * Gets the number of bytes usable at the given pointer, which is its allocation's size rounded up to whole units.
+ * @param bitmap The bitmap allocator the memory was allocated from.
+ * @param ptr The pointer at the first byte of allocated memory.
+ * @return The number of bytes, or 0 if ptr isn't a pointer returned by koi_bitmap_alloc for this allocator.
+ */
+extern size_t koi_bitmap_get_size(const koi_bitmap_t* bitmap, void* ptr);
+
+#ifdef __cplusplus
+};
+#endif
+
+
+#endif //STATIC_ALLOCATORS_BITMAP_ALLOCATOR_H
@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_BUDDY_ALLOCATOR_H
+#define STATIC_ALLOCATORS_BUDDY_ALLOCATOR_H
+
+
+
+
+#ifdef __cplusplus
+#include <cstdlib>
+extern "C" {
+#else
+#include <stdlib.h>
+#endif
+
+/**
+ * The size in bytes of the smallest block a buddy allocator hands out. Must be a power of 2 that can hold 2 pointers.
+ */
+#ifndef KOI_BUDDY_MIN_BLOCK_SIZE
+#define KOI_BUDDY_MIN_BLOCK_SIZE 32u
+#endif
+
+/**
+ * The most block sizes a buddy allocator can have, which bounds the biggest block to
+ * KOI_BUDDY_MIN_BLOCK_SIZE << (KOI_BUDDY_ORDER_COUNT_MAX - 1).
+ */
+#ifndef KOI_BUDDY_ORDER_COUNT_MAX
+#define KOI_BUDDY_ORDER_COUNT_MAX 32u
+#endif
+
+
+/**
+ * A power of 2 buddy allocator over memory supplied by its owner. Its members are managed by the koi_buddy_* functions.
+ * A block of order k is KOI_BUDDY_MIN_BLOCK_SIZE << k bytes, and splits into 2 buddies of order k - 1.
+ * memory: the first byte of the first block.
+ * bytes: the number of bytes that can be allocated. Blocks past it are never free, so they never merge.
+ * order_count: the number of block sizes. The whole memory is 1 virtual block of order order_count - 1.
+ * free_bits: a bitmap per order of which blocks are in a free list.
+ * split_bits: a bitmap per order of which blocks are split into buddies.
+ * free_lists: a doubly-linked list per order of free blocks, linked through the blocks themselves.
+ */
+typedef struct koi_buddy_t {
+    char* memory;
+    size_t bytes;
+    size_t order_count;
+    unsigned char* free_bits;
+    unsigned char* split_bits;
+    void* free_lists[KOI_BUDDY_ORDER_COUNT_MAX];
+} koi_buddy_t;
+
+
+/**
+ * Initializes a buddy allocator to manage the given memory. Its bitmaps are kept at the front of the memory, which
+ * must outlive the allocator's use.
+ * @param buddy The buddy allocator to initialize.
+ * @param buffer The memory to allocate from. Doesn't need to be aligned.
+ * @param bytes The number of bytes in buffer.
+ * @return 1 if successful, or 0 if the buffer is too small to hold a single block or too big for
+ * KOI_BUDDY_ORDER_COUNT_MAX.
+ */
+extern int koi_buddy_init(koi_buddy_t* buddy, void* buffer, size_t bytes);
+
+/**
+ * Allocates the number of bytes, rounded up to a power of 2 block, if a big enough block is free. Runs in O(log n).
+ * The bytes aren't zeroed, see koi_buddy_calloc.
+ * @param buddy The buddy allocator to allocate from.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate.
+ */
+extern void* koi_buddy_alloc(koi_buddy_t* buddy, size_t size);
+
+/**
+ * Allocates zeroed memory for the number of elements of the given size, if a big enough block is free.
+ * @param buddy The buddy allocator to allocate from.
+ * @param count The number of elements to allocate.
+ * @param size The number of bytes per element. If it or count is 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate or count * size overflows.
+ */
+extern void* koi_buddy_calloc(koi_buddy_t* buddy, size_t count, size_t size);
+
+/**
+ * Frees the memory allocated starting at the given pointer, merging it with its free buddies. Runs in O(log n).
+ * @param buddy The buddy allocator the memory was allocated from.
+ * @param ptr The pointer at the first byte of allocated memory that needs to be freed. If NULL, or not a pointer returned
+ * by koi_buddy_alloc for this allocator, does nothing.
+ * @return NULL.
+ */
+extern void* koi_buddy_free(koi_buddy_t* buddy, void* ptr);
+
+#ifdef __cplusplus
+};
+#endif
+
+
+#endif //STATIC_ALLOCATORS_BUDDY_ALLOCATOR_H
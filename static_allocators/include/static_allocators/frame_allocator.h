@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_FRAME_ALLOCATOR_H
+#define STATIC_ALLOCATORS_FRAME_ALLOCATOR_H
+
+
+
+
+#include "static_allocators/arena_allocator.h"
+
+#ifdef __cplusplus
+#include <cstdlib>
+extern "C" {
+#else
+#include <stdlib.h>
+#endif
+
+/**
+ * The most buffers a frame allocator can cycle through.
+ */
+#ifndef KOI_FRAME_BUFFER_COUNT_MAX
+#define KOI_FRAME_BUFFER_COUNT_MAX 4u
+#endif
+
+
+/**
+ * An N-buffered frame allocator over memory supplied by its owner, split into N equal arenas. Its members are managed
+ * by the koi_frame_* functions.
+ * Frame k bump allocates from buffer k % N. Beginning frame k resets that buffer, releasing everything frame k - N
+ * allocated at once, so frames never free individually, and the data of the N - 1 frames before stays valid. With 2
+ * buffers, 1 thread can fill frame k while another reads frame k - 1.
+ * arenas: the buffers, of which only the first buffer_count are used.
+ * buffer_count: the number of buffers, N.
+ * frame: the number of the current frame, starting at 0.
+ */
+typedef struct koi_frame_allocator_t {
+    koi_arena_t arenas[KOI_FRAME_BUFFER_COUNT_MAX];
+    size_t buffer_count;
+    size_t frame;
+} koi_frame_allocator_t;
+
+
+/**
+ * Initializes a frame allocator to split the given memory into the number of buffers, and begins frame 0. The memory
+ * must outlive the frame allocator's use.
+ * @param frames The frame allocator to initialize.
+ * @param buffer The memory to allocate from.
+ * @param bytes The number of bytes in buffer.
+ * @param buffer_count The number of buffers, from 1 to KOI_FRAME_BUFFER_COUNT_MAX. 2 double buffers.
+ * @return 1 if successful, or 0 if the arguments are invalid.
+ */
+extern int koi_frame_init(koi_frame_allocator_t* frames, void* buffer, size_t bytes, size_t buffer_count);
+
+/**
+ * Begins the next frame, releasing every allocation of the frame that used its buffer buffer_count frames ago in
+ * constant time. The caller must make sure nothing still reads that frame's data, for example by waiting on the
+ * thread consuming it.
+ * @param frames The frame allocator.
+ * @return The number of the frame that began.
+ */
+extern size_t koi_frame_begin(koi_frame_allocator_t* frames);
+
+/**
+ * Allocates the number of bytes, aligned to KOI_ARENA_DEFAULT_ALIGNMENT, from the current frame's buffer. The bytes
+ * aren't zeroed, see koi_frame_calloc.
+ * @param frames The frame allocator.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if the frame's buffer doesn't have enough space
+ * left.
+ */
+extern void* koi_frame_alloc(koi_frame_allocator_t* frames, size_t size);
+
+/**
+ * Allocates zeroed memory for the number of elements of the given size, aligned to KOI_ARENA_DEFAULT_ALIGNMENT, from the
+ * current frame's buffer.
+ * @param frames The frame allocator.
+ * @param count The number of elements to allocate.
+ * @param size The number of bytes per element. If it or count is 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if the frame's buffer doesn't have enough space
+ * left or count * size overflows.
+ */
+extern void* koi_frame_calloc(koi_frame_allocator_t* frames, size_t count, size_t size);
+
+/**
+ * Allocates the number of bytes, not zeroed and aligned to the given alignment, from the current frame's buffer.
+ * @param frames The frame allocator.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @param alignment The alignment of the first byte. Must be a power of 2.
+ * @return A pointer to the first byte in memory if successful, or NULL if the frame's buffer doesn't have enough space
+ * left or the alignment isn't a power of 2.
+ */
+extern void* koi_frame_alloc_aligned(koi_frame_allocator_t* frames, size_t size, size_t alignment);
+
+/**
+ * Gets the number of bytes the current frame has allocated, including padding for alignment.
+ */
+extern size_t koi_frame_get_used(const koi_frame_allocator_t* frames);
+
+#ifdef __cplusplus
+};
+#endif
+
+
+#endif //STATIC_ALLOCATORS_FRAME_ALLOCATOR_H
@@ -0,0 +1,160 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_HANDLE_ALLOCATOR_H
+#define STATIC_ALLOCATORS_HANDLE_ALLOCATOR_H
+
+
+
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstdlib>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stdlib.h>
+#endif
+
+/**
+ * The number of low bits of a handle that hold its index in the handle table. The remaining high bits hold its
+ * generation, which changes every time the index is reused, so a handle to freed memory never resolves again until
+ * its generation wraps around.
+ */
+#ifndef KOI_HANDLE_INDEX_BITS
+#define KOI_HANDLE_INDEX_BITS 20u
+#endif
+
+/**
+ * The most handles a pool can have live at once.
+ */
+#define KOI_HANDLE_MAX_COUNT ((uint32_t)1u << KOI_HANDLE_INDEX_BITS)
+
+/**
+ * The alignment of every allocation's data, enough for any fundamental type on common platforms.
+ */
+#define KOI_HANDLE_ALIGNMENT (2u * sizeof(void*))
+
+/**
+ * A handle that never resolves, returned when an allocation fails.
+ */
+#define KOI_HANDLE_NULL ((koi_handle_t)0u)
+
+
+/**
+ * A reference to an allocation in a koi_handle_pool_t, made of an index into the pool's handle table and a generation.
+ */
+typedef uint32_t koi_handle_t;
+
+struct koi_handle_entry_t;
+
+/**
+ * A compacting memory pool over memory supplied by its owner, whose allocations are referenced by handles instead of
+ * pointers. Its members are managed by the koi_handle_* functions.
+ * Allocations are laid out back to back in a heap and always bump the top of the heap. Freeing leaves a hole, which
+ * koi_handle_compact closes by sliding the live allocations after it down and updating their handles, a little at a
+ * time if asked to.
+ * entries: the handle table, which holds where each handle's allocation currently is.
+ * entry_count: the number of entries in the handle table.
+ * free_entry: the index of the first unused entry, or entry_count if all are in use.
+ * heap: the first byte of the heap.
+ * heap_bytes: the number of bytes in the heap.
+ * top: the number of bytes from the start of the heap to the end of the last allocation.
+ * hole_bytes: the number of bytes in holes below top, which compaction can give back.
+ * compact_end: while compacting, where the next live allocation moves to.
+ * compact_scan: while compacting, the next allocation to look at. Between compact_end and compact_scan is free space.
+ */
+typedef struct koi_handle_pool_t {
+    struct koi_handle_entry_t* entries;
+    uint32_t entry_count;
+    uint32_t free_entry;
+    char* heap;
+    size_t heap_bytes;
+    size_t top;
+    size_t hole_bytes;
+    size_t compact_end;
+    size_t compact_scan;
+} koi_handle_pool_t;
+
+
+/**
+ * Initializes a handle pool over the given memory, which is split between the handle table at its front and the heap.
+ * The memory must outlive the pool's use.
+ * @param pool The handle pool to initialize.
+ * @param buffer The memory to use. Doesn't need to be aligned.
+ * @param bytes The number of bytes in buffer.
+ * @param handle_count The most allocations that can be live at once. At most KOI_HANDLE_MAX_COUNT.
+ * @return 1 if successful, or 0 if the arguments are invalid or the buffer can't hold the handle table.
+ */
+extern int koi_handle_pool_init(koi_handle_pool_t* pool, void* buffer, size_t bytes, uint32_t handle_count);
+
+/**
+ * Allocates the number of bytes, not zeroed, at the top of the heap in constant time. Holes left by freed allocations
+ * are only reused after koi_handle_compact closes them.
+ * @param pool The handle pool to allocate from.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @return The allocation's handle if successful, or KOI_HANDLE_NULL if the top of the heap or the handle table is full.
+ */
+extern koi_handle_t koi_handle_alloc(koi_handle_pool_t* pool, size_t size);
+
+/**
+ * Frees the allocation of the given handle in constant time, after which the handle no longer resolves.
+ * @param pool The handle pool the handle was allocated from.
+ * @param handle The handle to free. If KOI_HANDLE_NULL, or already freed, does nothing.
+ */
+extern void koi_handle_free(koi_handle_pool_t* pool, koi_handle_t handle);
+
+/**
+ * Resolves a handle to its allocation's current address in constant time. The address stays valid until the next call
+ * to koi_handle_compact, which can move the allocation.
+ * @param pool The handle pool the handle was allocated from.
+ * @param handle The handle to resolve.
+ * @return A pointer to the allocation's first byte, or NULL if the handle is KOI_HANDLE_NULL or was freed.
+ */
+extern void* koi_handle_get(const koi_handle_pool_t* pool, koi_handle_t handle);
+
+/**
+ * Closes the holes left by freed allocations by sliding live allocations down, continuing where the previous call
+ * stopped. Each call moves and scans at most roughly the given number of bytes, so compaction can be spread over many
+ * calls, such as 1 per frame, with a bounded cost each. Allocations and frees may happen between calls.
+ * @param pool The handle pool to compact.
+ * @param byte_budget The number of bytes this call may move or scan. At least 1 allocation is always handled.
+ * @return 1 if the heap has no holes left, or 0 if more calls are needed.
+ */
+extern int koi_handle_compact(koi_handle_pool_t* pool, size_t byte_budget);
+
+/**
+ * Gets the number of bytes free at the top of the heap, which bounds the biggest allocation that can succeed.
+ * Allocations also spend KOI_HANDLE_ALIGNMENT bytes on a header and are rounded up to KOI_HANDLE_ALIGNMENT.
+ * @param pool The handle pool to inspect.
+ */
+extern size_t koi_handle_get_available(const koi_handle_pool_t* pool);
+
+#ifdef __cplusplus
+};
+#endif
+
+
+#endif //STATIC_ALLOCATORS_HANDLE_ALLOCATOR_H
@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_LOCK_FREE_BLOCK_POOL_HPP
+#define STATIC_ALLOCATORS_LOCK_FREE_BLOCK_POOL_HPP
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Koi {
+
+/**
+ * A pool of BlockCount blocks of BlockSize bytes stored inside the object itself, which any number of threads can
+ * allocate from and free to without a lock. Declaring it static reserves its memory statically, like the static
+ * memory pool behind koi_static_alloc.
+ * Free blocks form a Treiber stack. Its head packs the top block's index and a tag into 1 64-bit atomic, and every
+ * push and pop increments the tag, so a compare-exchange made with a stale head fails even when the same block is back
+ * on top (the ABA problem). The links are kept in an array beside the blocks rather than in the free blocks, so a
+ * thread reading a link while another thread writes to the block it just popped is not a data race.
+ * Every block is aligned to Alignment, which must be a power of 2.
+ */
+template<size_t BlockSize, size_t BlockCount, size_t Alignment = alignof(std::max_align_t)>
+class LockFreeBlockPool final {
+public:
+    static constexpr size_t alignment = Alignment;
+    static constexpr size_t block_size = (BlockSize + Alignment - 1u) / Alignment * Alignment;
+    static constexpr size_t block_count = BlockCount;
+
+private:
+    /**
+     * Indices in the stack are 1 more than the block's, so 0 can mean none.
+     */
+    static constexpr uint32_t none = 0u;
+
+    alignas(Alignment) unsigned char _memory[block_count * block_size];
+    std::atomic<uint32_t> _next[block_count];
+
+    // alone on its cache line, since the pool's size is rounded up to its alignment, so threads racing on it don't
+    // also slow down reads of the links
+    alignas(64) std::atomic<uint64_t> _head;
+
+public:
+    LockFreeBlockPool(): _head(0u) {
+        static_assert(Alignment > 0u && (Alignment & (Alignment - 1u)) == 0u, "Alignment must be a power of 2.");
+        static_assert(BlockSize > 0u && BlockCount > 0u, "A LockFreeBlockPool needs at least 1 block of 1 byte.");
+        static_assert(BlockCount < UINT32_MAX, "A LockFreeBlockPool's blocks must be countable in 32 bits.");
+
+        // every block starts free, in address order
+        for (size_t i = 0u; i < block_count; ++i) {
+            _next[i].store(i + 1u < block_count ? (uint32_t)(i + 2u) : none, std::memory_order_relaxed);
+        }
+
+        _head.store(pack(0u, 1u), std::memory_order_release);
+    }
+
+    /**
+     * Destroying the pool doesn't destroy objects that are still alive in its memory.
+     */
+    ~LockFreeBlockPool() = default;
+
+    LockFreeBlockPool(const LockFreeBlockPool& rhs) = delete;
+    LockFreeBlockPool(LockFreeBlockPool&& rhs) = delete;
+    LockFreeBlockPool& operator=(const LockFreeBlockPool& rhs) = delete;
+    LockFreeBlockPool& operator=(LockFreeBlockPool&& rhs) = delete;
+
+    /**
+     * Allocates a block, not zeroed. Can be called by any thread.
+     * @return A pointer to the block if successful, or nullptr if every block is allocated.
+     */
+    void* alloc() {
+        uint64_t head = _head.load(std::memory_order_acquire);
+
+        while (true) {
+            uint32_t top = (uint32_t)head;
+            if (top == none) {
+                return nullptr;
+            }
+
+            // the link may be stale if another thread popped top meanwhile, but then the tag changed and this fails.
+            // The acquire pairs with the release in free, so the block's last writes happen before it is handed out
+            uint32_t next = _next[top - 1u].load(std::memory_order_relaxed);
+
+            if (_head.compare_exchange_weak(head, pack(head, next), std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                return &_memory[(top - 1u) * block_size];
+            }
+        }
+    }
+
+    /**
+     * Frees a block allocated from this pool. Can be called by any thread. If nullptr, or not pointing at a block of
+     * this pool, does nothing. Freeing a block twice isn't detected.
+     * @return nullptr.
+     */
+    void* free(void* ptr) {
+        unsigned char* address = static_cast<unsigned char*>(ptr);
+        if (ptr == nullptr || address < &_memory[0u] || address >= &_memory[0u] + block_count * block_size
+            || (size_t)(address - &_memory[0u]) % block_size != 0u) {
+            return nullptr;
+        }
+
+        uint32_t top = (uint32_t)((size_t)(address - &_memory[0u]) / block_size + 1u);
+        uint64_t head = _head.load(std::memory_order_relaxed);
+
+        do {
+            _next[top - 1u].store((uint32_t)head, std::memory_order_relaxed);
+        } while (!_head.compare_exchange_weak(head, pack(head, top), std::memory_order_release,
+                                              std::memory_order_relaxed));
+
+        return nullptr;
+    }
+
+    /**
+     * Gets whether the pool's head is lock-free on this platform. Without a lock-free 64-bit compare-exchange, the
+     * pool still works but std::atomic falls back to a lock.
+     */
+    bool is_lock_free() const {
+        return _head.is_lock_free();
+    }
+
+private:
+    static uint64_t pack(uint64_t head, uint32_t top) {
+        // the tag is the high 32 bits, wrapping around after 2^32 changes, which a stale head won't live to see
+        return ((head >> 32u) + 1u) << 32u | top;
+    }
+};
+
+
+template<size_t BlockSize, size_t BlockCount, size_t Alignment>
+constexpr size_t LockFreeBlockPool<BlockSize, BlockCount, Alignment>::alignment;
+
+template<size_t BlockSize, size_t BlockCount, size_t Alignment>
+constexpr size_t LockFreeBlockPool<BlockSize, BlockCount, Alignment>::block_size;
+
+template<size_t BlockSize, size_t BlockCount, size_t Alignment>
+constexpr size_t LockFreeBlockPool<BlockSize, BlockCount, Alignment>::block_count;
+
+template<size_t BlockSize, size_t BlockCount, size_t Alignment>
+constexpr uint32_t LockFreeBlockPool<BlockSize, BlockCount, Alignment>::none;
+
+} // Koi
+
+#endif //STATIC_ALLOCATORS_LOCK_FREE_BLOCK_POOL_HPP
@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_MAPPED_POOL_H
+#define STATIC_ALLOCATORS_MAPPED_POOL_H
+
+
+
+
+#include "static_allocators/allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Asks koi_pool_map for transparent huge pages, where the OS supports them, to cut TLB misses on big pools.
+ */
+#define KOI_POOL_MAP_HUGE_PAGES 1u
+
+
+/**
+ * Initializes a memory pool over memory mapped from the OS, so its size can be picked at runtime instead of with
+ * KOI_MEMORY_POOL_SIZE. The address space is only reserved up front: pages are committed when the pool first touches
+ * them, so an unused tail costs no memory. The pool allocates and frees like any other, and must be released with
+ * koi_pool_unmap.
+ * On Linux and other POSIX systems the memory is mapped with mmap, and with KOI_POOL_MAP_HUGE_PAGES it is aligned to
+ * huge pages and advised with MADV_HUGEPAGE. On Windows it is reserved and committed with VirtualAlloc, which still
+ * only backs pages once touched, and KOI_POOL_MAP_HUGE_PAGES is ignored because large pages need a privilege and are
+ * never lazy.
+ * @param pool The memory pool to initialize.
+ * @param bytes The number of bytes to map, rounded up to whole pages.
+ * @param flags 0, or KOI_POOL_MAP_HUGE_PAGES.
+ * @return 1 if successful, or 0 if the memory couldn't be mapped or bytes is too small to hold a single allocation.
+ */
+extern int koi_pool_map(koi_pool_t* pool, size_t bytes, unsigned int flags);
+
+/**
+ * Returns the memory of a pool initialized with koi_pool_map to the OS. Every allocation from it becomes invalid.
+ * @param pool The memory pool to release. If it wasn't initialized with koi_pool_map, the behaviour is undefined.
+ */
+extern void koi_pool_unmap(koi_pool_t* pool);
+
+#ifdef __cplusplus
+};
+#endif
+
+
+#endif //STATIC_ALLOCATORS_MAPPED_POOL_H
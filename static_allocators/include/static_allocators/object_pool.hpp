@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_OBJECT_POOL_HPP
+#define STATIC_ALLOCATORS_OBJECT_POOL_HPP
+
+
+#include "static_allocators/slab_allocator.h"
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+
+namespace Koi {
+
+/**
+ * A fixed pool of up to N objects of type T, backed by a slab over storage inside the pool itself. Objects are
+ * constructed and destroyed in place, in constant time, without any per-object overhead.
+ */
+template<typename T, size_t N>
+class ObjectPool final {
+public:
+    static constexpr size_t alignment = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+    static constexpr size_t stride = KOI_SLAB_STRIDE(sizeof(T), alignment);
+
+private:
+    alignas(alignment) unsigned char _buffer[N * stride];
+    koi_slab_t _slab;
+
+public:
+    ObjectPool(): _slab() {
+        static_assert(N > 0u, "An ObjectPool must hold at least 1 object.");
+        koi_slab_init(&_slab, _buffer, sizeof(_buffer), sizeof(T), alignment);
+    }
+
+    /**
+     * Destroying the pool doesn't destroy objects that are still alive.
+     */
+    ~ObjectPool() = default;
+
+    ObjectPool(const ObjectPool& rhs) = delete;
+    ObjectPool(ObjectPool&& rhs) = delete;
+    ObjectPool& operator=(const ObjectPool& rhs) = delete;
+    ObjectPool& operator=(ObjectPool&& rhs) = delete;
+
+    /**
+     * Constructs an object in the pool with the given constructor arguments. If the constructor throws, the exception
+     * is rethrown and the object's memory stays free.
+     * @return The object, or nullptr if the pool is full.
+     */
+    template<typename... Args>
+    T* create(Args&&... args) {
+        void* memory = koi_slab_alloc(&_slab);
+        if (memory == nullptr) {
+            return nullptr;
+        }
+
+        // the memory goes back to the slab if the constructor throws, or the pool would lose it for good
+        try {
+            return new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            koi_slab_free(&_slab, memory);
+            throw;
+        }
+    }
+
+    /**
+     * Destroys an object created by this pool and returns its memory to the pool. If nullptr, does nothing.
+     */
+    void destroy(T* object) {
+        if (object == nullptr) {
+            return;
+        }
+
+        object->~T();
+        koi_slab_free(&_slab, object);
+    }
+};
+
+
+template<typename T, size_t N>
+constexpr size_t ObjectPool<T, N>::alignment;
+
+template<typename T, size_t N>
+constexpr size_t ObjectPool<T, N>::stride;
+
+} // Koi
+
+#endif //STATIC_ALLOCATORS_OBJECT_POOL_HPP
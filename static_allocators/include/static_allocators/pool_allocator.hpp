@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_POOL_ALLOCATOR_HPP
+#define STATIC_ALLOCATORS_POOL_ALLOCATOR_HPP
+
+
+#include "static_allocators/allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+
+namespace Koi {
+
+/**
+ * A std::allocator compatible allocator over a koi_pool_t, or over the static memory pool of the koi_static_* functions
+ * when default constructed. Copies, and rebound copies, allocate from the same pool. Throws std::bad_alloc when the pool
+ * can't fit an allocation, as standard containers expect.
+ * Containers that regrow arrays, like std::unordered_map's buckets, leave freed arrays early in the pool, and first fit,
+ * the default KOI_FIT_POLICY, then walks past every live node after them: std::unordered_map runs about 100x slower
+ * than on std::allocator. Build with FIT_POLICY=BEST for such containers, which brings it within 20%. Node containers
+ * such as std::map and std::list run at about the speed of std::allocator under either policy.
+ */
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<typename U>
+    friend class PoolAllocator;
+
+private:
+    koi_pool_t* _pool;
+
+public:
+    /**
+     * Allocates from the static memory pool, which must be initialized with koi_static_init before use.
+     */
+    PoolAllocator() noexcept: _pool(nullptr) {
+    }
+
+    /**
+     * Allocates from the given pool, which must outlive every allocation made through this allocator and its copies.
+     */
+    explicit PoolAllocator(koi_pool_t* pool) noexcept: _pool(pool) {
+    }
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& rhs) noexcept: _pool(rhs._pool) {
+    }
+
+    /**
+     * Allocates memory for n objects, aligned for T. Allocates 1 byte if n is 0, so the pointer is still unique.
+     * @throw std::bad_alloc if the pool can't fit the allocation.
+     */
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+
+        // like PoolMemoryResource, 0 objects still get a unique pointer rather than the NULL the pool returns for 0 bytes
+        size_t bytes = n == 0u ? 1u : n * sizeof(T);
+        size_t alignment = alignof(T) > KOI_POOL_ALIGNMENT ? alignof(T) : KOI_POOL_ALIGNMENT;
+        void* result = _pool == nullptr
+                ? koi_static_alloc_aligned(bytes, alignment)
+                : koi_pool_alloc_aligned(_pool, bytes, alignment);
+
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(result);
+    }
+
+    /**
+     * Frees memory allocated by an allocator equal to this one.
+     */
+    void deallocate(T* ptr, size_t) noexcept {
+        if (_pool == nullptr) {
+            koi_static_free(ptr);
+        } else {
+            koi_pool_free(_pool, ptr);
+        }
+    }
+
+    /**
+     * Gets the pool allocated from, or nullptr for the static memory pool.
+     */
+    koi_pool_t* get_pool() const noexcept {
+        return _pool;
+    }
+};
+
+
+template<typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) noexcept {
+    return lhs.get_pool() == rhs.get_pool();
+}
+
+template<typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+} // Koi
+
+#endif //STATIC_ALLOCATORS_POOL_ALLOCATOR_HPP
@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_POOL_MEMORY_RESOURCE_HPP
+#define STATIC_ALLOCATORS_POOL_MEMORY_RESOURCE_HPP
+
+
+#include "static_allocators/allocator.h"
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#endif
+
+#ifdef __cpp_lib_memory_resource
+
+#include <cstddef>
+#include <new>
+
+
+namespace Koi {
+
+/**
+ * A std::pmr::memory_resource over a koi_pool_t, or over the static memory pool of the koi_static_* functions when
+ * default constructed. Only available from C++17, when the standard library provides std::pmr.
+ * Like PoolAllocator, use FIT_POLICY=BEST for containers that regrow arrays, which are slow to search past under first
+ * fit.
+ */
+class PoolMemoryResource final : public std::pmr::memory_resource {
+private:
+    koi_pool_t* _pool;
+
+public:
+    /**
+     * Allocates from the static memory pool, which must be initialized with koi_static_init before use.
+     */
+    PoolMemoryResource() noexcept: _pool(nullptr) {
+    }
+
+    /**
+     * Allocates from the given pool, which must outlive every allocation made through this resource.
+     */
+    explicit PoolMemoryResource(koi_pool_t* pool) noexcept: _pool(pool) {
+    }
+
+    /**
+     * Gets the pool allocated from, or nullptr for the static memory pool.
+     */
+    koi_pool_t* get_pool() const noexcept {
+        return _pool;
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        // memory resources must return a unique pointer even for 0 bytes
+        if (bytes == 0u) {
+            bytes = 1u;
+        }
+
+        void* result = _pool == nullptr
+                ? koi_static_alloc_aligned(bytes, alignment)
+                : koi_pool_alloc_aligned(_pool, bytes, alignment);
+
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return result;
+    }
+
+    void do_deallocate(void* ptr, size_t, size_t) override {
+        if (_pool == nullptr) {
+            koi_static_free(ptr);
+        } else {
+            koi_pool_free(_pool, ptr);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        const PoolMemoryResource* resource = dynamic_cast<const PoolMemoryResource*>(&other);
+        return resource != nullptr && resource->_pool == _pool;
+    }
+};
+
+} // Koi
+
+#endif //__cpp_lib_memory_resource
+
+#endif //STATIC_ALLOCATORS_POOL_MEMORY_RESOURCE_HPP
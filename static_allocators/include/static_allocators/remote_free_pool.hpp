@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_REMOTE_FREE_POOL_HPP
+#define STATIC_ALLOCATORS_REMOTE_FREE_POOL_HPP
+
+
+#include "static_allocators/allocator.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+
+namespace Koi {
+
+/**
+ * A koi_pool_t owned by 1 thread, which is the only one that allocates from it, while any thread can free to it. Frees
+ * from the owner go straight to the pool. Frees from other threads are pushed onto a lock-free list of remote frees,
+ * linked through the freed memory itself, which the owner takes in 1 exchange and returns to the pool on its next
+ * allocation. Neither path takes a lock, which suits a producer allocating messages that consumers free.
+ */
+class RemoteFreePool final {
+private:
+    /**
+     * The link written over the first bytes of an allocation freed by another thread.
+     */
+    struct RemoteFree {
+        RemoteFree* next;
+    };
+
+    koi_pool_t _pool;
+    std::thread::id _owner;
+    std::atomic<RemoteFree*> _remote_frees;
+
+public:
+    RemoteFreePool();
+
+    RemoteFreePool(const RemoteFreePool& rhs) = delete;
+    RemoteFreePool(RemoteFreePool&& rhs) = delete;
+    RemoteFreePool& operator=(const RemoteFreePool& rhs) = delete;
+    RemoteFreePool& operator=(RemoteFreePool&& rhs) = delete;
+
+    /**
+     * Initializes the pool to manage the given memory, making the calling thread its owner. Must be called before any
+     * thread uses the pool.
+     * @return Whether successful. See koi_pool_init.
+     */
+    bool init(void* buffer, size_t bytes);
+
+    /**
+     * Allocates the number of bytes, not zeroed, after returning every remote free to the pool. Must only be called by
+     * the owner.
+     * @return A pointer to the first byte in memory if successful, or nullptr if couldn't allocate.
+     */
+    void* alloc(size_t size);
+
+    /**
+     * Frees the memory allocated from this pool. Can be called by any thread. If nullptr, or outside the pool's memory,
+     * does nothing. Unlike koi_pool_free, a pointer inside the pool that alloc didn't return is only caught if the
+     * owner frees it.
+     * @return nullptr.
+     */
+    void* free(void* ptr);
+
+    /**
+     * Returns every remote free to the pool without allocating, for example before the owner checks the pool's stats.
+     * Must only be called by the owner.
+     */
+    void drain();
+
+    /**
+     * Gets the pool, for the koi_pool_* functions that only read it. Must only be used by the owner.
+     */
+    const koi_pool_t* get_pool() const;
+};
+
+} // Koi
+
+#endif //STATIC_ALLOCATORS_REMOTE_FREE_POOL_HPP
@@ -0,0 +1,121 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_SHARDED_POOL_HPP
+#define STATIC_ALLOCATORS_SHARDED_POOL_HPP
+
+
+#include "static_allocators/allocator.h"
+
+#include <cstddef>
+#include <mutex>
+
+
+/**
+ * The most shards a sharded pool can split its memory into.
+ */
+#ifndef KOI_SHARDED_POOL_MAX_SHARDS
+#define KOI_SHARDED_POOL_MAX_SHARDS 64u
+#endif
+
+
+namespace Koi {
+
+/**
+ * A pool for many threads that splits 1 region into equal shards, each a koi_pool_t behind its own lock. A thread
+ * allocates from the shard of the CPU it runs on, or on platforms without a way to ask, from a shard picked per thread
+ * round robin, so threads on different CPUs rarely take the same lock. Only when its shard can't fit an allocation does
+ * it steal from the next shards in turn. Frees go back to the shard that owns the address, whichever thread frees.
+ * No allocation can be bigger than 1 shard.
+ */
+class ShardedPool final {
+private:
+    /**
+     * 1 shard, aligned to a cache line so threads working on neighbouring shards don't share lines.
+     */
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        koi_pool_t pool;
+    };
+
+    Shard _shards[KOI_SHARDED_POOL_MAX_SHARDS];
+    size_t _shard_count;
+    size_t _shard_bytes;
+    char* _memory;
+
+    /**
+     * Gets the index of the shard the calling thread allocates from first.
+     */
+    size_t get_home_shard() const;
+
+    /**
+     * Gets the index of the shard whose memory holds ptr, or _shard_count if no shard's does.
+     */
+    size_t get_shard(const void* ptr) const;
+
+public:
+    ShardedPool();
+
+    ShardedPool(const ShardedPool& rhs) = delete;
+    ShardedPool(ShardedPool&& rhs) = delete;
+    ShardedPool& operator=(const ShardedPool& rhs) = delete;
+    ShardedPool& operator=(ShardedPool&& rhs) = delete;
+
+    /**
+     * Initializes the pool to split the given memory into shards. Must be called before any thread uses the pool.
+     * @param shard_count The number of shards, up to KOI_SHARDED_POOL_MAX_SHARDS, or 0 for 1 per hardware thread.
+     * @return Whether successful, which fails if shard_count is too big or a shard is too small to hold a single
+     * allocation.
+     */
+    bool init(void* buffer, size_t bytes, size_t shard_count = 0u);
+
+    /**
+     * Allocates the number of bytes, not zeroed, from the calling thread's shard, or another shard if it can't.
+     * @return A pointer to the first byte in memory if successful, or nullptr if couldn't allocate.
+     */
+    void* alloc(size_t size);
+
+    /**
+     * Allocates count * size bytes, zeroed, like alloc.
+     * @return A pointer to the first byte in memory if successful, or nullptr if couldn't allocate or the total size
+     * overflows.
+     */
+    void* calloc(size_t count, size_t size);
+
+    /**
+     * Frees the memory allocated from this pool, from any thread.
+     * @return nullptr.
+     */
+    void* free(void* ptr);
+
+    /**
+     * Gets the number of shards the memory was split into.
+     */
+    size_t get_shard_count() const;
+};
+
+} // Koi
+
+#endif //STATIC_ALLOCATORS_SHARDED_POOL_HPP
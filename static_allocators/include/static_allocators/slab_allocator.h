@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_SLAB_ALLOCATOR_H
+#define STATIC_ALLOCATORS_SLAB_ALLOCATOR_H
+
+
+
+
+#ifdef __cplusplus
+#include <cstdlib>
+extern "C" {
+#else
+#include <stdlib.h>
+#endif
+
+/**
+ * The distance in bytes between 2 objects in a slab. Objects are at least pointer-sized so a free object can hold the
+ * link to the next free object, and are rounded up to their alignment, which must be a power of 2. koi_slab_init raises
+ * an alignment smaller than a pointer's to a pointer's first, so only pass such alignments here for the same stride.
+ */
+#define KOI_SLAB_STRIDE(size, alignment) \
+    ((((size) > sizeof(void*) ? (size) : sizeof(void*)) + (alignment) - 1u) & ~((size_t)(alignment) - 1u))
+
+
+/**
+ * A slab of same-sized objects over memory supplied by its owner. Its members are managed by the koi_slab_* functions.
+ * There is no per-object metadata: free objects are linked through their own first bytes.
+ * memory: the first object of the slab.
+ * stride: the distance in bytes between 2 objects. See KOI_SLAB_STRIDE.
+ * capacity: the number of objects in the slab.
+ * used: the number of objects that have ever been handed out. Objects after these have never been touched.
+ * free_list: the most recently freed object, or NULL if none.
+ */
+typedef struct koi_slab_t {
+    char* memory;
+    size_t stride;
+    size_t capacity;
+    size_t used;
+    void* free_list;
+} koi_slab_t;
+
+
+/**
+ * Initializes a slab to hand out objects of the given size from the given memory. The memory must outlive the slab's
+ * use. Runs in constant time.
+ * @param slab The slab to initialize.
+ * @param buffer The memory to allocate from. Doesn't need to be aligned.
+ * @param bytes The number of bytes in buffer.
+ * @param size The size of an object in bytes.
+ * @param alignment The alignment of an object in bytes. Must be a power of 2. Rounded up to pointer alignment.
+ * @return 1 if successful, or 0 if the arguments are invalid or the buffer is too small to hold a single object.
+ */
+extern int koi_slab_init(koi_slab_t* slab, void* buffer, size_t bytes, size_t size, size_t alignment);
+
+/**
+ * Allocates 1 object from the slab in constant time, if any is left. The object isn't zeroed, see koi_slab_calloc.
+ * @param slab The slab to allocate from.
+ * @return A pointer to the object if successful, or NULL if the slab is full.
+ */
+extern void* koi_slab_alloc(koi_slab_t* slab);
+
+/**
+ * Allocates 1 zeroed object from the slab, if any is left.
+ * @param slab The slab to allocate from.
+ * @return A pointer to the object if successful, or NULL if the slab is full.
+ */
+extern void* koi_slab_calloc(koi_slab_t* slab);
+
+/**
+ * Frees the object at the given pointer in constant time. Freeing an object twice isn't detected.
+ * @param slab The slab the object was allocated from.
+ * @param ptr The pointer to the object. If NULL, or not pointing at an object of this slab, does nothing.
+ * @return NULL.
+ */
+extern void* koi_slab_free(koi_slab_t* slab, void* ptr);
+
+#ifdef __cplusplus
+};
+#endif
+
+
+#endif //STATIC_ALLOCATORS_SLAB_ALLOCATOR_H
@@ -0,0 +1,323 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_STATIC_POOL_HPP
+#define STATIC_ALLOCATORS_STATIC_POOL_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+
+namespace Koi {
+
+/**
+ * The fit policies a StaticPool can use to pick the free section for an allocation, like KOI_FIT_POLICY does for
+ * koi_pool_t.
+ * FirstFit: the earliest free section big enough.
+ * NextFit: the first free section big enough after the last allocation, wrapping around to the start of the pool.
+ * BestFit: the smallest free section big enough, and the earliest of those. Unlike koi_pool_t's, it searches every free
+ * section rather than a tree, which keeps the pool's bookkeeping to 4 indices per section.
+ */
+struct FirstFit {};
+struct NextFit {};
+struct BestFit {};
+
+
+/**
+ * A memory pool of Bytes bytes stored inside the object itself, using the free list algorithm of koi_pool_t: the pool
+ * is divided into blocks, and every section of it, allocated or free, starts with a block holding its header, with the
+ * sections chained in address order so neighbours merge on free.
+ * The geometry is fixed at compile time, so each instantiation is sized on its own and the index arithmetic folds into
+ * shifts and masks. Headers link sections by index instead of pointer, in the smallest unsigned type that can count
+ * the blocks, so blocks are smaller than koi_pool_t's.
+ * Every allocation is aligned to Alignment, which must be a power of 2.
+ */
+template<size_t Bytes, size_t Alignment = alignof(std::max_align_t), typename Policy = FirstFit>
+class StaticPool final {
+private:
+    using Index = typename std::conditional<Bytes / Alignment < UINT16_MAX, uint16_t,
+                  typename std::conditional<Bytes / Alignment < UINT32_MAX, uint32_t, size_t>::type>::type;
+
+    /**
+     * The header of a section.
+     * next, previous: the neighbouring sections in address order, or none.
+     * capacity: the number of blocks of data if the section is free, or 0 if it is allocated.
+     * size: the number of blocks of data if the section is allocated, or 0 if it is free.
+     */
+    struct Header {
+        Index next;
+        Index previous;
+        Index capacity;
+        Index size;
+    };
+
+    static constexpr Index none = (Index)~(Index)0u;
+
+public:
+    static constexpr size_t alignment = Alignment;
+    static constexpr size_t block_size = (sizeof(Header) + Alignment - 1u) / Alignment * Alignment;
+    static constexpr size_t block_count = Bytes / block_size;
+
+private:
+    alignas(Alignment) unsigned char _memory[block_count * block_size];
+    Index _free_list;
+    Index _rover;
+
+public:
+    StaticPool(): _free_list(0u), _rover(0u) {
+        static_assert(Alignment > 0u && (Alignment & (Alignment - 1u)) == 0u, "Alignment must be a power of 2.");
+        static_assert(block_count >= 2u, "A StaticPool needs room for at least 1 header and 1 block of data.");
+        static_assert(block_count < none, "A StaticPool's blocks must be countable by its index type.");
+
+        new (&_memory[0u]) Header{none, none, (Index)(block_count - 1u), 0u};
+    }
+
+    /**
+     * Destroying the pool doesn't destroy objects that are still alive in its memory.
+     */
+    ~StaticPool() = default;
+
+    StaticPool(const StaticPool& rhs) = delete;
+    StaticPool(StaticPool&& rhs) = delete;
+    StaticPool& operator=(const StaticPool& rhs) = delete;
+    StaticPool& operator=(StaticPool&& rhs) = delete;
+
+    /**
+     * Allocates the number of bytes, not zeroed, from the free section the Policy picks.
+     * @return A pointer to the first byte in memory if successful, or nullptr if size is 0 or couldn't allocate.
+     */
+    void* alloc(size_t size) {
+        if (size == 0u || size > (block_count - 1u) * block_size || _free_list == none) {
+            return nullptr;
+        }
+
+        Index blocks_needed = (Index)((size + block_size - 1u) / block_size);
+        Index index = find_fit(blocks_needed, Policy());
+        if (index == none) {
+            return nullptr;
+        }
+
+        Header& header = get_header(index);
+
+        // split the space after the allocation off into its own free section
+        if (header.capacity > blocks_needed) {
+            Index split = (Index)(index + blocks_needed + 1u);
+            new (&_memory[split * block_size]) Header{header.next, index, (Index)(header.capacity - blocks_needed - 1u), 0u};
+
+            if (header.next != none) {
+                get_header(header.next).previous = split;
+            }
+
+            header.next = split;
+        }
+
+        header.size = blocks_needed;
+        header.capacity = 0u;
+
+        // if this was the earliest free section, move the free list up to the next free section
+        if (index == _free_list) {
+            while (_free_list != none && get_header(_free_list).size > 0u) {
+                _free_list = get_header(_free_list).next;
+            }
+        }
+
+        _rover = header.next != none ? header.next : (Index)0u;
+
+        return &_memory[(index + 1u) * block_size];
+    }
+
+    /**
+     * Frees the memory allocated from this pool starting at the given pointer, merging it with its free neighbours, in
+     * constant time. If nullptr, or not a pointer returned by alloc for this pool, does nothing.
+     * @return nullptr.
+     */
+    void* free(void* ptr) {
+        Index index = ptr != nullptr ? get_index(ptr) : none;
+        if (index == none) {
+            return nullptr;
+        }
+
+        Header* header = &get_header(index);
+        Index capacity = header->size;
+
+        // merge the next section into this one if it is free, +1 for its header
+        if (header->next != none && get_header(header->next).size == 0u) {
+            Header& next = get_header(header->next);
+
+            if (_rover == header->next) {
+                _rover = index;
+            }
+
+            capacity = (Index)(capacity + next.capacity + 1u);
+            header->next = next.next;
+
+            if (header->next != none) {
+                get_header(header->next).previous = index;
+            }
+        }
+
+        // merge this section into the previous one if it is free
+        if (header->previous != none && get_header(header->previous).size == 0u) {
+            Index previous = header->previous;
+            Header& previous_header = get_header(previous);
+
+            if (_rover == index) {
+                _rover = previous;
+            }
+
+            capacity = (Index)(capacity + previous_header.capacity + 1u);
+            previous_header.next = header->next;
+
+            if (previous_header.next != none) {
+                get_header(previous_header.next).previous = previous;
+            }
+
+            // this header is now part of the previous section's data, so make sure it can't be freed again
+            header->size = 0u;
+            header = &previous_header;
+            index = previous;
+        }
+
+        header->capacity = capacity;
+        header->size = 0u;
+
+        if (_free_list == none || index < _free_list) {
+            _free_list = index;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * Gets the number of bytes usable at the given pointer, which is its allocation's size rounded up to whole blocks.
+     * @return The number of bytes, or 0 if ptr isn't a pointer returned by alloc for this pool.
+     */
+    size_t get_size(void* ptr) {
+        Index index = ptr != nullptr ? get_index(ptr) : none;
+        if (index == none) {
+            return 0u;
+        }
+
+        return get_header(index).size * block_size;
+    }
+
+private:
+    Header& get_header(Index index) {
+        return *reinterpret_cast<Header*>(&_memory[index * block_size]);
+    }
+
+    Index find_fit(Index blocks_needed, FirstFit) {
+        Index index = _free_list;
+
+        while (index != none && get_header(index).capacity < blocks_needed) {
+            index = get_header(index).next;
+        }
+
+        return index;
+    }
+
+    Index find_fit(Index blocks_needed, NextFit) {
+        // search from the rover to the end of the pool, then wrap around to its start and search up to the rover
+        Index index = _rover;
+
+        while (get_header(index).capacity < blocks_needed) {
+            index = get_header(index).next != none ? get_header(index).next : (Index)0u;
+
+            if (index == _rover) {
+                return none;
+            }
+        }
+
+        return index;
+    }
+
+    Index find_fit(Index blocks_needed, BestFit) {
+        Index result = none;
+
+        for (Index index = _free_list; index != none; index = get_header(index).next) {
+            Index capacity = get_header(index).capacity;
+
+            if (capacity >= blocks_needed && (result == none || capacity < get_header(result).capacity)) {
+                result = index;
+
+                // nothing fits better than an exact fit
+                if (capacity == blocks_needed) {
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    Index get_index(void* ptr) {
+        unsigned char* data = static_cast<unsigned char*>(ptr);
+        if (data <= _memory || data >= _memory + block_count * block_size) {
+            return none;
+        }
+
+        size_t offset = (size_t)(data - _memory);
+        if (offset % block_size != 0u) {
+            return none;
+        }
+
+        // the block before ptr must be the header of an allocation that the section before it links to
+        Index index = (Index)(offset / block_size - 1u);
+        Header& header = get_header(index);
+        if (header.size == 0u) {
+            return none;
+        }
+
+        if (header.previous == none) {
+            return index == 0u ? index : none;
+        }
+
+        if (header.previous >= index || get_header(header.previous).next != index) {
+            return none;
+        }
+
+        return index;
+    }
+};
+
+
+template<size_t Bytes, size_t Alignment, typename Policy>
+constexpr typename StaticPool<Bytes, Alignment, Policy>::Index StaticPool<Bytes, Alignment, Policy>::none;
+
+template<size_t Bytes, size_t Alignment, typename Policy>
+constexpr size_t StaticPool<Bytes, Alignment, Policy>::alignment;
+
+template<size_t Bytes, size_t Alignment, typename Policy>
+constexpr size_t StaticPool<Bytes, Alignment, Policy>::block_size;
+
+template<size_t Bytes, size_t Alignment, typename Policy>
+constexpr size_t StaticPool<Bytes, Alignment, Policy>::block_count;
+
+} // Koi
+
+#endif //STATIC_ALLOCATORS_STATIC_POOL_HPP
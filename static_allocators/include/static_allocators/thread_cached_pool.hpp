@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_THREAD_CACHED_POOL_HPP
+#define STATIC_ALLOCATORS_THREAD_CACHED_POOL_HPP
+
+
+#include "static_allocators/allocator.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+
+
+/**
+ * The biggest allocation, in bytes, that is cached per thread. Bigger allocations always go to the shared pool.
+ */
+#ifndef KOI_THREAD_CACHE_MAX_SIZE
+#define KOI_THREAD_CACHE_MAX_SIZE 256u
+#endif
+
+/**
+ * The number of freed allocations each thread can cache per size class.
+ */
+#ifndef KOI_THREAD_CACHE_MAGAZINE_SIZE
+#define KOI_THREAD_CACHE_MAGAZINE_SIZE 32u
+#endif
+
+
+namespace Koi {
+
+/**
+ * A koi_pool_t that can be shared between threads. Each thread caches a small magazine of freed allocations per size
+ * class, so most allocations and frees take no lock. An empty magazine is refilled from, and a full one is drained to,
+ * the shared pool in batches under a single lock.
+ * Each thread's cache is returned to the shared pool when the thread exits or calls flush().
+ */
+class ThreadCachedPool final {
+public:
+    static constexpr size_t class_count = (KOI_THREAD_CACHE_MAX_SIZE + KOI_BLOCK_SIZE - 1u) / KOI_BLOCK_SIZE;
+    static constexpr size_t magazine_size = KOI_THREAD_CACHE_MAGAZINE_SIZE;
+
+    // the number of allocations moved between a magazine and the shared pool at once
+    static constexpr size_t batch_size = (magazine_size + 1u) / 2u;
+
+private:
+    struct Magazine;
+    struct Cache;
+    struct ThreadCaches;
+
+    static std::atomic<uint64_t> _next_id;
+    static std::mutex _registry_mutex;
+    static std::unordered_set<uint64_t> _live_ids;
+    static thread_local ThreadCaches _thread_caches;
+
+    koi_pool_t _pool;
+    std::mutex _mutex;
+    uint64_t _id;
+
+public:
+    ThreadCachedPool();
+    ~ThreadCachedPool();
+
+    ThreadCachedPool(const ThreadCachedPool& rhs) = delete;
+    ThreadCachedPool(ThreadCachedPool&& rhs) = delete;
+    ThreadCachedPool& operator=(const ThreadCachedPool& rhs) = delete;
+    ThreadCachedPool& operator=(ThreadCachedPool&& rhs) = delete;
+
+    /**
+     * Initializes the shared pool to manage the given memory. Must be called before any thread uses the pool.
+     * @return Whether successful. See koi_pool_init.
+     */
+    bool init(void* buffer, size_t bytes);
+
+    /**
+     * Allocates the number of bytes, not zeroed, from the calling thread's cache or the shared pool.
+     * @return A pointer to the first byte in memory if successful, or nullptr if couldn't allocate.
+     */
+    void* alloc(size_t size);
+
+    /**
+     * Allocates zeroed memory for the number of elements of the given size from the calling thread's cache or the
+     * shared pool.
+     * @return A pointer to the first byte in memory if successful, or nullptr if couldn't allocate or count * size
+     * overflows.
+     */
+    void* calloc(size_t count, size_t size);
+
+    /**
+     * Frees the memory allocated from this pool by any thread into the calling thread's cache. Freeing an allocation
+     * twice while it is still cached isn't detected, and 2 later allocations get the same memory. Debug builds (without
+     * NDEBUG) ignore a second free of an allocation in the calling thread's cache.
+     * @return nullptr.
+     */
+    void* free(void* ptr);
+
+    /**
+     * Returns every allocation in the calling thread's cache to the shared pool.
+     */
+    void flush();
+
+private:
+    Cache* get_cache();
+    void refill(Magazine& magazine, size_t size);
+    void drain(Magazine& magazine, size_t count);
+};
+
+} // Koi
+
+#endif //STATIC_ALLOCATORS_THREAD_CACHED_POOL_HPP
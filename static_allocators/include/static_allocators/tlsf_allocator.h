@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_TLSF_ALLOCATOR_H
+#define STATIC_ALLOCATORS_TLSF_ALLOCATOR_H
+
+
+
+
+#ifdef __cplusplus
+#include <cstdlib>
+extern "C" {
+#else
+#include <stdlib.h>
+#endif
+
+/**
+ * The log2 of the number of second level lists each first level (power of 2 size range) is divided into.
+ */
+#define KOI_TLSF_SL_COUNT_LOG2 4u
+#define KOI_TLSF_SL_COUNT (1u << KOI_TLSF_SL_COUNT_LOG2)
+
+/**
+ * The number of first level lists. The first covers every size smaller than 16 alignment units, and each of the others
+ * covers a power of 2 size range, so the biggest block is around 2^28 alignment units (4 GB on 64-bit platforms).
+ */
+#define KOI_TLSF_FL_COUNT 25u
+
+
+struct koi_tlsf_block_t;
+
+/**
+ * A two-level segregated fit (TLSF) allocator over memory supplied by its owner. Its members are managed by the
+ * koi_tlsf_* functions.
+ * memory: the first block.
+ * bytes: the number of bytes managed, including block headers.
+ * fl_bitmap: which first level lists have a non-empty second level list.
+ * sl_bitmaps: which second level lists of each first level list have a free block.
+ * free_lists: doubly-linked lists of free blocks, linked through the blocks themselves.
+ */
+typedef struct koi_tlsf_t {
+    char* memory;
+    size_t bytes;
+    unsigned int fl_bitmap;
+    unsigned int sl_bitmaps[KOI_TLSF_FL_COUNT];
+    struct koi_tlsf_block_t* free_lists[KOI_TLSF_FL_COUNT][KOI_TLSF_SL_COUNT];
+} koi_tlsf_t;
+
+
+/**
+ * Gets the number of bytes each allocation spends on its block header.
+ */
+extern size_t koi_tlsf_get_header_size(void);
+
+/**
+ * Initializes a TLSF allocator to manage the given memory. The memory must outlive the allocator's use.
+ * @param tlsf The TLSF allocator to initialize.
+ * @param buffer The memory to allocate from. Doesn't need to be aligned. Memory past the biggest block is unused.
+ * @param bytes The number of bytes in buffer.
+ * @return 1 if successful, or 0 if the buffer is too small to hold a single allocation.
+ */
+extern int koi_tlsf_init(koi_tlsf_t* tlsf, void* buffer, size_t bytes);
+
+/**
+ * Allocates the number of bytes, if a big enough block is free. Runs in constant time, in the worst case too.
+ * Allocations are aligned to 2 pointers. The bytes aren't zeroed, see koi_tlsf_calloc.
+ * @param tlsf The TLSF allocator to allocate from.
+ * @param size The number of bytes to allocate. If 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate.
+ */
+extern void* koi_tlsf_alloc(koi_tlsf_t* tlsf, size_t size);
+
+/**
+ * Allocates zeroed memory for the number of elements of the given size, if a big enough block is free. Zeroing takes
+ * time in proportion to the size, on top of koi_tlsf_alloc.
+ * @param tlsf The TLSF allocator to allocate from.
+ * @param count The number of elements to allocate.
+ * @param size The number of bytes per element. If it or count is 0, does nothing.
+ * @return A pointer to the first byte in memory if successful, or NULL if couldn't allocate or count * size overflows.
+ */
+extern void* koi_tlsf_calloc(koi_tlsf_t* tlsf, size_t count, size_t size);
+
+/**
+ * Frees the memory allocated starting at the given pointer, merging it with its free neighbours. Runs in constant time,
+ * in the worst case too.
+ * @param tlsf The TLSF allocator the memory was allocated from.
+ * @param ptr The pointer at the first byte of allocated memory that needs to be freed. If NULL, or not a pointer returned
+ * by koi_tlsf_alloc for this allocator, does nothing.
+ * @return NULL.
+ */
+extern void* koi_tlsf_free(koi_tlsf_t* tlsf, void* ptr);
+
+#ifdef __cplusplus
+};
+#endif
+
+
+#endif //STATIC_ALLOCATORS_TLSF_ALLOCATOR_H
@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef STATIC_ALLOCATORS_TRACE_HPP
+#define STATIC_ALLOCATORS_TRACE_HPP
+
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+
+namespace Koi {
+
+/**
+ * 1 allocation or free in a trace.
+ * timestamp: the nanoseconds since the trace started.
+ * id: the allocation's id, unique among live allocations.
+ * size: the number of bytes allocated, or 0 for a free.
+ */
+struct TraceRecord {
+    uint64_t timestamp;
+    uint32_t id;
+    uint32_t size;
+};
+
+/**
+ * Records allocations and frees into a compact binary trace file, such as every call to a memory pool traced with
+ * koi_pool_set_trace. The file starts with the 8 bytes "KOITRACE", followed by 1 record per call of 16 bytes: the
+ * timestamp as a little-endian uint64, then the id and the size as little-endian uint32s. Records are buffered and
+ * written in batches.
+ */
+class TraceWriter final {
+public:
+    static constexpr size_t record_size = 16u;
+
+private:
+    // the number of records buffered before they are written
+    static constexpr size_t buffer_records = 4096u;
+
+    FILE* _file;
+    std::chrono::steady_clock::time_point _start;
+    std::vector<unsigned char> _buffer;
+
+public:
+    TraceWriter();
+
+    /**
+     * Closes the file, writing any buffered records.
+     */
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter& rhs) = delete;
+    TraceWriter(TraceWriter&& rhs) = delete;
+    TraceWriter& operator=(const TraceWriter& rhs) = delete;
+    TraceWriter& operator=(TraceWriter&& rhs) = delete;
+
+    /**
+     * Creates the trace file at the given path, closing any file already open, and starts the trace's clock.
+     * @return Whether the file could be created.
+     */
+    bool open(const char* path);
+
+    /**
+     * Records an allocation, or a free if size is 0. Sizes and ids that don't fit 32 bits are saturated. Does nothing if
+     * no file is open.
+     */
+    void record(size_t id, size_t size);
+
+    /**
+     * Writes any buffered records and closes the file.
+     */
+    void close();
+
+    /**
+     * Records an allocation or free into the TraceWriter pointed to by user_data. Matches koi_trace_callback_t, so it
+     * can be passed to koi_pool_set_trace with the TraceWriter as its user data.
+     */
+    static void callback(void* user_data, size_t id, size_t size);
+
+private:
+    void flush();
+};
+
+/**
+ * Reads every record of a trace file written by TraceWriter.
+ * @return Whether the file could be read and is a trace file. A partially written last record is ignored.
+ */
+bool read_trace(const char* path, std::vector<TraceRecord>& records);
+
+} // Koi
+
+#endif //STATIC_ALLOCATORS_TRACE_HPP
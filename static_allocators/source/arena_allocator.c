@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * A linear allocator that bumps an offset through a single buffer. Freeing happens only in bulk, by moving the offset
+ * back to a marker or to the start.
+ */
+
+
+#include "static_allocators/arena_allocator.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+
+int koi_arena_init(koi_arena_t* arena, void* buffer, size_t bytes) {
+    if (arena == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    arena->memory = (char*)buffer;
+    arena->capacity = bytes;
+    arena->offset = 0u;
+
+    return 1;
+}
+
+
+void* koi_arena_alloc(koi_arena_t* arena, size_t size) {
+    return koi_arena_alloc_aligned(arena, size, KOI_ARENA_DEFAULT_ALIGNMENT);
+}
+
+
+void* koi_arena_calloc(koi_arena_t* arena, size_t count, size_t size) {
+    if (size != 0u && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void* result = koi_arena_alloc(arena, count * size);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    memset(result, '\0', count * size);
+
+    return result;
+}
+
+
+void* koi_arena_alloc_aligned(koi_arena_t* arena, size_t size, size_t alignment) {
+    if (size == 0u || alignment == 0u || (alignment & (alignment - 1u)) != 0u) {
+        return NULL;
+    }
+
+    // align the address rather than the offset, since the buffer itself might not be aligned
+    uintptr_t address = (uintptr_t)(arena->memory + arena->offset);
+    size_t padding = (alignment - (address & (alignment - 1u))) & (alignment - 1u);
+
+    // compare against what's left rather than adding to the offset, so huge sizes can't overflow
+    size_t remaining = arena->capacity - arena->offset;
+    if (padding > remaining || size > remaining - padding) {
+        return NULL;
+    }
+
+    char* result = arena->memory + arena->offset + padding;
+    arena->offset += padding + size;
+
+    return result;
+}
+
+
+koi_arena_marker_t koi_arena_mark(const koi_arena_t* arena) {
+    return arena->offset;
+}
+
+
+void koi_arena_rewind_to_mark(koi_arena_t* arena, koi_arena_marker_t marker) {
+    if (marker <= arena->offset) {
+        arena->offset = marker;
+    }
+}
+
+
+void koi_arena_reset(koi_arena_t* arena) {
+    arena->offset = 0u;
+}
@@ -0,0 +1,334 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * A bitmap allocator. Instead of a header per allocation, 1 bitmap records which units are allocated and a second
+ * records which unit ends each allocation, both kept at the front of the buffer. Allocations are therefore packed with
+ * no gaps, and finding a free run only reads the bitmaps, skipping a whole word of full units at a time.
+ */
+
+
+#include "static_allocators/bitmap_allocator.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+#define KOI_BITMAP_WORD_BITS (sizeof(size_t) * 8u)
+#define KOI_BITMAP_ALL_BITS (~(size_t)0u)
+
+/**
+ * The bitmaps are kept in the first units, so a unit must be aligned enough for a bitmap word.
+ */
+typedef char unit_size_check[(KOI_BITMAP_UNIT_SIZE % sizeof(size_t) == 0u) ? 1 : -1];
+
+
+/**
+ * Gets the index of the lowest set bit of a non-zero word.
+ */
+static size_t find_first_set(size_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll((unsigned long long)word);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (size_t)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, (unsigned long)word);
+    return (size_t)index;
+#else
+    size_t index = 0u;
+    while ((word & 1u) == 0u) {
+        word >>= 1u;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+
+/**
+ * Gets the mask of the bits at and after the given index in its word.
+ */
+static size_t get_mask_from(size_t index) {
+    return KOI_BITMAP_ALL_BITS << (index % KOI_BITMAP_WORD_BITS);
+}
+
+
+static int is_set(const size_t* bits, size_t index) {
+    return (bits[index / KOI_BITMAP_WORD_BITS] >> (index % KOI_BITMAP_WORD_BITS)) & 1u;
+}
+
+
+/**
+ * Finds the first unit at or after start whose bit is set, or clear if invert is all bits, reading a word at a time.
+ * @return The unit's index, or limit if there is none before limit.
+ */
+static size_t find_next(const size_t* bits, size_t start, size_t limit, size_t invert) {
+    if (start >= limit) {
+        return limit;
+    }
+
+    size_t word_index = start / KOI_BITMAP_WORD_BITS;
+    size_t last_word_index = (limit - 1u) / KOI_BITMAP_WORD_BITS;
+    size_t word = (bits[word_index] ^ invert) & get_mask_from(start);
+
+    while (word == 0u) {
+        if (word_index == last_word_index) {
+            return limit;
+        }
+
+        word = bits[++word_index] ^ invert;
+    }
+
+    size_t index = word_index * KOI_BITMAP_WORD_BITS + find_first_set(word);
+
+    return index < limit ? index : limit;
+}
+
+
+/**
+ * Sets, or clears if value is 0, the bits of count units starting at start, a word at a time.
+ */
+static void set_range(size_t* bits, size_t start, size_t count, int value) {
+    size_t end = start + count;
+
+    while (start < end) {
+        size_t word_index = start / KOI_BITMAP_WORD_BITS;
+        size_t word_end = (word_index + 1u) * KOI_BITMAP_WORD_BITS;
+        size_t mask = get_mask_from(start);
+
+        if (end < word_end) {
+            mask &= ~get_mask_from(end);
+        }
+
+        if (value) {
+            bits[word_index] |= mask;
+        } else {
+            bits[word_index] &= ~mask;
+        }
+
+        start = word_end;
+    }
+}
+
+
+/**
+ * Finds the first run of free units, no longer than a word, at or after start. Each word's free bits are ANDed with
+ * themselves shifted by 1 to count - 1 units, shifting in the next word's, which leaves a bit set at every unit that
+ * starts a free run long enough. Short runs scattered across the bitmap are therefore rejected a word at a time.
+ * @return The run's first unit, or unit_count if there is none.
+ */
+static size_t find_short_run(const koi_bitmap_t* bitmap, size_t start, size_t count) {
+    if (start >= bitmap->unit_count) {
+        return bitmap->unit_count;
+    }
+
+    size_t word_count = (bitmap->unit_count + KOI_BITMAP_WORD_BITS - 1u) / KOI_BITMAP_WORD_BITS;
+    size_t word_index = start / KOI_BITMAP_WORD_BITS;
+    size_t free_bits = ~bitmap->used_bits[word_index] & get_mask_from(start);
+
+    for (; word_index < word_count; ++word_index) {
+        size_t next_free_bits = word_index + 1u < word_count ? ~bitmap->used_bits[word_index + 1u] : 0u;
+        size_t starts = free_bits;
+
+        for (size_t i = 1u; i < count && starts != 0u; ++i) {
+            starts &= (free_bits >> i) | (next_free_bits << (KOI_BITMAP_WORD_BITS - i));
+        }
+
+        // the units past the last 1 read as free, but any run reaching into them comes after every valid run
+        if (starts != 0u) {
+            size_t index = word_index * KOI_BITMAP_WORD_BITS + find_first_set(starts);
+            return index + count <= bitmap->unit_count ? index : bitmap->unit_count;
+        }
+
+        free_bits = next_free_bits;
+    }
+
+    return bitmap->unit_count;
+}
+
+
+/**
+ * Finds the first run of free units, longer than a word, at or after start, by alternating between finding the start
+ * of a free run and its end, which stops as soon as the run is long enough.
+ * @return The run's first unit, or unit_count if there is none.
+ */
+static size_t find_long_run(const koi_bitmap_t* bitmap, size_t start, size_t count) {
+    while (1) {
+        start = find_next(bitmap->used_bits, start, bitmap->unit_count, KOI_BITMAP_ALL_BITS);
+        if (bitmap->unit_count - start < count) {
+            return bitmap->unit_count;
+        }
+
+        size_t end = find_next(bitmap->used_bits, start, start + count, 0u);
+        if (end - start == count) {
+            return start;
+        }
+
+        start = end;
+    }
+}
+
+
+/**
+ * Gets the unit of an allocation's first byte.
+ * @return The unit's index, or unit_count if ptr doesn't point at the start of an allocation.
+ */
+static size_t get_unit(const koi_bitmap_t* bitmap, void* ptr) {
+    if ((char*)ptr < bitmap->memory) {
+        return bitmap->unit_count;
+    }
+
+    size_t offset = (size_t)((char*)ptr - bitmap->memory);
+    size_t unit = offset / KOI_BITMAP_UNIT_SIZE;
+
+    if (offset % KOI_BITMAP_UNIT_SIZE != 0u || unit >= bitmap->unit_count) {
+        return bitmap->unit_count;
+    }
+
+    // an allocation starts at an allocated unit right after a free unit or the end of another allocation
+    if (!is_set(bitmap->used_bits, unit)) {
+        return bitmap->unit_count;
+    }
+
+    if (unit > 0u && is_set(bitmap->used_bits, unit - 1u) && !is_set(bitmap->end_bits, unit - 1u)) {
+        return bitmap->unit_count;
+    }
+
+    return unit;
+}
+
+
+int koi_bitmap_init(koi_bitmap_t* bitmap, void* buffer, size_t bytes) {
+    if (bitmap == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    // skip the bytes at the front of the buffer that aren't aligned for a unit
+    size_t padding = (KOI_BITMAP_UNIT_SIZE - ((uintptr_t)buffer % KOI_BITMAP_UNIT_SIZE)) % KOI_BITMAP_UNIT_SIZE;
+    if (bytes < padding) {
+        return 0;
+    }
+
+    // size the bitmaps for the whole buffer, then take them out of its front
+    size_t word_count = ((bytes - padding) / KOI_BITMAP_UNIT_SIZE + KOI_BITMAP_WORD_BITS - 1u) / KOI_BITMAP_WORD_BITS;
+    size_t metadata_bytes = 2u * word_count * sizeof(size_t);
+    metadata_bytes = (metadata_bytes + KOI_BITMAP_UNIT_SIZE - 1u) / KOI_BITMAP_UNIT_SIZE * KOI_BITMAP_UNIT_SIZE;
+
+    if (bytes - padding < metadata_bytes + KOI_BITMAP_UNIT_SIZE) {
+        return 0;
+    }
+
+    char* aligned = (char*)buffer + padding;
+    bitmap->used_bits = (size_t*)aligned;
+    bitmap->end_bits = (size_t*)aligned + word_count;
+    bitmap->memory = aligned + metadata_bytes;
+    bitmap->unit_count = (bytes - padding - metadata_bytes) / KOI_BITMAP_UNIT_SIZE;
+    bitmap->search_start = 0u;
+
+    memset(bitmap->used_bits, 0, 2u * word_count * sizeof(size_t));
+
+    return 1;
+}
+
+
+void* koi_bitmap_alloc(koi_bitmap_t* bitmap, size_t size) {
+    if (size == 0u || size > bitmap->unit_count * KOI_BITMAP_UNIT_SIZE) {
+        return NULL;
+    }
+
+    size_t units_needed = (size + KOI_BITMAP_UNIT_SIZE - 1u) / KOI_BITMAP_UNIT_SIZE;
+    size_t first_free = find_next(bitmap->used_bits, bitmap->search_start, bitmap->unit_count, KOI_BITMAP_ALL_BITS);
+
+    size_t start;
+    if (units_needed <= KOI_BITMAP_WORD_BITS) {
+        start = find_short_run(bitmap, first_free, units_needed);
+    } else {
+        start = find_long_run(bitmap, first_free, units_needed);
+    }
+
+    if (start == bitmap->unit_count) {
+        bitmap->search_start = first_free;
+        return NULL;
+    }
+
+    set_range(bitmap->used_bits, start, units_needed, 1);
+    set_range(bitmap->end_bits, start + units_needed - 1u, 1u, 1);
+
+    // every unit before the first free run is allocated, so if this run was it, the search can skip past it next time
+    bitmap->search_start = first_free == start ? start + units_needed : first_free;
+
+    return bitmap->memory + start * KOI_BITMAP_UNIT_SIZE;
+}
+
+
+void* koi_bitmap_free(koi_bitmap_t* bitmap, void* ptr) {
+    if (ptr == NULL) {
+        return NULL;
+    }
+
+    size_t unit = get_unit(bitmap, ptr);
+    if (unit == bitmap->unit_count) {
+        return NULL;
+    }
+
+    size_t last = find_next(bitmap->end_bits, unit, bitmap->unit_count, 0u);
+
+    set_range(bitmap->used_bits, unit, last - unit + 1u, 0);
+    set_range(bitmap->end_bits, last, 1u, 0);
+
+    if (unit < bitmap->search_start) {
+        bitmap->search_start = unit;
+    }
+
+    return NULL;
+}
+
+
+size_t koi_bitmap_get_size(const koi_bitmap_t* bitmap, void* ptr) {
+    if (ptr == NULL) {
+        return 0u;
+    }
+
+    size_t unit = get_unit(bitmap, ptr);
+    if (unit == bitmap->unit_count) {
+        return 0u;
+    }
+
+    size_t last = find_next(bitmap->end_bits, unit, bitmap->unit_count, 0u);
+
+    return (last - unit + 1u) * KOI_BITMAP_UNIT_SIZE;
+}
@@ -0,0 +1,292 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * A buddy allocator that splits its memory into power of 2 blocks. Each order has a doubly-linked free list through
+ * the free blocks themselves, plus 2 bitmaps: which blocks are free, and which blocks are split into buddies. Finding a
+ * block's buddy is a flip of the lowest bit of its index, so splitting and merging walk at most 1 block per order.
+ */
+
+
+#include "static_allocators/buddy_allocator.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+
+/**
+ * The links of a free block in its order's free list.
+ */
+typedef struct koi_buddy_node_t {
+    struct koi_buddy_node_t* next;
+    struct koi_buddy_node_t* previous;
+} Node;
+
+
+/**
+ * Gets the number of block sizes needed for 1 virtual block to cover the given number of smallest blocks.
+ */
+static size_t get_order_count(size_t block_count) {
+    size_t result = 1u;
+
+    while (((size_t)1u << (result - 1u)) < block_count && result <= KOI_BUDDY_ORDER_COUNT_MAX) {
+        ++result;
+    }
+
+    return result;
+}
+
+
+/**
+ * Gets the index of a block's bit in a bitmap. Each order's bits follow the previous order's: the smallest blocks
+ * first, then half as many for the next order and so on.
+ */
+static size_t get_bit_index(const koi_buddy_t* buddy, size_t order, size_t index) {
+    size_t bit_count = (size_t)2u << (buddy->order_count - 1u);
+    return bit_count - (bit_count >> order) + index;
+}
+
+
+static int get_bit(const unsigned char* bits, size_t index) {
+    return (bits[index >> 3u] >> (index & 7u)) & 1u;
+}
+
+
+static void set_bit(unsigned char* bits, size_t index) {
+    bits[index >> 3u] |= (unsigned char)(1u << (index & 7u));
+}
+
+
+static void clear_bit(unsigned char* bits, size_t index) {
+    bits[index >> 3u] &= (unsigned char)~(1u << (index & 7u));
+}
+
+
+static Node* get_node(const koi_buddy_t* buddy, size_t order, size_t index) {
+    return (Node*)(buddy->memory + ((index << order) * KOI_BUDDY_MIN_BLOCK_SIZE));
+}
+
+
+static void push_free(koi_buddy_t* buddy, size_t order, size_t index) {
+    Node* node = get_node(buddy, order, index);
+    Node* head = (Node*)buddy->free_lists[order];
+
+    node->next = head;
+    node->previous = NULL;
+
+    if (head != NULL) {
+        head->previous = node;
+    }
+
+    buddy->free_lists[order] = node;
+    set_bit(buddy->free_bits, get_bit_index(buddy, order, index));
+}
+
+
+static void remove_free(koi_buddy_t* buddy, size_t order, size_t index) {
+    Node* node = get_node(buddy, order, index);
+
+    if (node->previous != NULL) {
+        node->previous->next = node->next;
+    } else {
+        buddy->free_lists[order] = node->next;
+    }
+
+    if (node->next != NULL) {
+        node->next->previous = node->previous;
+    }
+
+    clear_bit(buddy->free_bits, get_bit_index(buddy, order, index));
+}
+
+
+/**
+ * Frees the given block if it is entirely inside the allocatable memory, or else splits it and does the same for its
+ * buddies. Blocks entirely past the allocatable memory are left alone, so they look allocated forever.
+ */
+static void init_block(koi_buddy_t* buddy, size_t order, size_t index) {
+    size_t block_count = buddy->bytes / KOI_BUDDY_MIN_BLOCK_SIZE;
+    size_t first = index << order;
+
+    if (first + ((size_t)1u << order) <= block_count) {
+        push_free(buddy, order, index);
+    } else if (first < block_count) {
+        set_bit(buddy->split_bits, get_bit_index(buddy, order, index));
+        init_block(buddy, order - 1u, index << 1u);
+        init_block(buddy, order - 1u, (index << 1u) + 1u);
+    }
+}
+
+
+int koi_buddy_init(koi_buddy_t* buddy, void* buffer, size_t bytes) {
+    if (buddy == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    // skip the bytes at the front of the buffer that aren't aligned for a block
+    size_t padding = (KOI_BUDDY_MIN_BLOCK_SIZE - ((uintptr_t)buffer % KOI_BUDDY_MIN_BLOCK_SIZE)) % KOI_BUDDY_MIN_BLOCK_SIZE;
+    if (bytes < padding) {
+        return 0;
+    }
+
+    // size the bitmaps for the whole buffer, then take them out of its front
+    size_t order_count = get_order_count((bytes - padding) / KOI_BUDDY_MIN_BLOCK_SIZE);
+    if (order_count > KOI_BUDDY_ORDER_COUNT_MAX) {
+        return 0;
+    }
+
+    size_t bitmap_bytes = (((size_t)2u << (order_count - 1u)) + 7u) / 8u;
+    size_t metadata_bytes = 2u * bitmap_bytes;
+    metadata_bytes = (metadata_bytes + KOI_BUDDY_MIN_BLOCK_SIZE - 1u) / KOI_BUDDY_MIN_BLOCK_SIZE * KOI_BUDDY_MIN_BLOCK_SIZE;
+
+    if (bytes - padding < metadata_bytes + KOI_BUDDY_MIN_BLOCK_SIZE) {
+        return 0;
+    }
+
+    char* aligned = (char*)buffer + padding;
+    buddy->free_bits = (unsigned char*)aligned;
+    buddy->split_bits = (unsigned char*)aligned + bitmap_bytes;
+    buddy->memory = aligned + metadata_bytes;
+    buddy->bytes = (bytes - padding - metadata_bytes) / KOI_BUDDY_MIN_BLOCK_SIZE * KOI_BUDDY_MIN_BLOCK_SIZE;
+
+    // the bitmaps lost some blocks, so fewer orders might be enough now
+    buddy->order_count = get_order_count(buddy->bytes / KOI_BUDDY_MIN_BLOCK_SIZE);
+
+    memset(buddy->free_bits, 0, bitmap_bytes);
+    memset(buddy->split_bits, 0, bitmap_bytes);
+    memset(buddy->free_lists, 0, sizeof(buddy->free_lists));
+
+    init_block(buddy, buddy->order_count - 1u, 0u);
+
+    return 1;
+}
+
+
+void* koi_buddy_alloc(koi_buddy_t* buddy, size_t size) {
+    if (size == 0u || size > buddy->bytes) {
+        return NULL;
+    }
+
+    // get the smallest order that fits
+    size_t order = 0u;
+    while (((size_t)KOI_BUDDY_MIN_BLOCK_SIZE << order) < size) {
+        ++order;
+    }
+
+    // get the smallest free block that is at least that big
+    size_t free_order = order;
+    while (free_order < buddy->order_count && buddy->free_lists[free_order] == NULL) {
+        ++free_order;
+    }
+
+    if (free_order == buddy->order_count) {
+        return NULL;
+    }
+
+    size_t offset = (size_t)((char*)buddy->free_lists[free_order] - buddy->memory) / KOI_BUDDY_MIN_BLOCK_SIZE;
+    size_t index = offset >> free_order;
+    remove_free(buddy, free_order, index);
+
+    // split the block down to the order needed, freeing the upper buddy of each split
+    while (free_order > order) {
+        set_bit(buddy->split_bits, get_bit_index(buddy, free_order, index));
+        --free_order;
+        index <<= 1u;
+        push_free(buddy, free_order, index + 1u);
+    }
+
+    return get_node(buddy, order, index);
+}
+
+
+void* koi_buddy_calloc(koi_buddy_t* buddy, size_t count, size_t size) {
+    if (size != 0u && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void* result = koi_buddy_alloc(buddy, count * size);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    memset(result, '\0', count * size);
+
+    return result;
+}
+
+
+void* koi_buddy_free(koi_buddy_t* buddy, void* ptr) {
+    char* block = (char*)ptr;
+
+    if (block == NULL || block < buddy->memory || block >= buddy->memory + buddy->bytes) {
+        return NULL;
+    }
+
+    size_t offset = (size_t)(block - buddy->memory);
+    if (offset % KOI_BUDDY_MIN_BLOCK_SIZE != 0u) {
+        return NULL;
+    }
+
+    offset /= KOI_BUDDY_MIN_BLOCK_SIZE;
+
+    // the allocation is the first block down from the top that isn't split
+    size_t order = buddy->order_count - 1u;
+    size_t index = offset >> order;
+
+    while (order > 0u && get_bit(buddy->split_bits, get_bit_index(buddy, order, index))) {
+        --order;
+        index = offset >> order;
+    }
+
+    // if ptr is inside the block rather than at its start, or the block is already free, it isn't an allocation
+    if ((index << order) != offset || get_bit(buddy->free_bits, get_bit_index(buddy, order, index))) {
+        return NULL;
+    }
+
+    // merge with the buddy for as long as it is free too
+    while (order + 1u < buddy->order_count) {
+        size_t buddy_index = index ^ 1u;
+
+        if (!get_bit(buddy->free_bits, get_bit_index(buddy, order, buddy_index))) {
+            break;
+        }
+
+        remove_free(buddy, order, buddy_index);
+        index >>= 1u;
+        ++order;
+        clear_bit(buddy->split_bits, get_bit_index(buddy, order, index));
+    }
+
+    push_free(buddy, order, index);
+
+    return NULL;
+}
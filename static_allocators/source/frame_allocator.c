@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * An N-buffered frame allocator. Each buffer is an arena, and a frame owns the buffer of its number modulo N from when
+ * it begins until the frame N later begins and resets it.
+ */
+
+
+#include "static_allocators/frame_allocator.h"
+
+
+int koi_frame_init(koi_frame_allocator_t* frames, void* buffer, size_t bytes, size_t buffer_count) {
+    if (frames == NULL || buffer == NULL || buffer_count == 0u || buffer_count > KOI_FRAME_BUFFER_COUNT_MAX) {
+        return 0;
+    }
+
+    // every buffer gets the same number of bytes, rounded down so they all start equally aligned
+    size_t buffer_bytes = bytes / buffer_count / KOI_ARENA_DEFAULT_ALIGNMENT * KOI_ARENA_DEFAULT_ALIGNMENT;
+    if (buffer_bytes == 0u) {
+        return 0;
+    }
+
+    for (size_t i = 0u; i < buffer_count; ++i) {
+        koi_arena_init(&frames->arenas[i], (char*)buffer + i * buffer_bytes, buffer_bytes);
+    }
+
+    frames->buffer_count = buffer_count;
+    frames->frame = 0u;
+
+    return 1;
+}
+
+
+size_t koi_frame_begin(koi_frame_allocator_t* frames) {
+    ++frames->frame;
+    koi_arena_reset(&frames->arenas[frames->frame % frames->buffer_count]);
+
+    return frames->frame;
+}
+
+
+void* koi_frame_alloc(koi_frame_allocator_t* frames, size_t size) {
+    return koi_arena_alloc(&frames->arenas[frames->frame % frames->buffer_count], size);
+}
+
+
+void* koi_frame_calloc(koi_frame_allocator_t* frames, size_t count, size_t size) {
+    return koi_arena_calloc(&frames->arenas[frames->frame % frames->buffer_count], count, size);
+}
+
+
+void* koi_frame_alloc_aligned(koi_frame_allocator_t* frames, size_t size, size_t alignment) {
+    return koi_arena_alloc_aligned(&frames->arenas[frames->frame % frames->buffer_count], size, alignment);
+}
+
+
+size_t koi_frame_get_used(const koi_frame_allocator_t* frames) {
+    return koi_arena_mark(&frames->arenas[frames->frame % frames->buffer_count]);
+}
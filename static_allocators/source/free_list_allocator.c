@@ -26,6 +26,8 @@
 /**
  * A static allocator that uses a doubly-linked free list and other metadata to manage its memory allocations.
  * It uses an array of Block structs that each store a pointer to the allocated data and its own metadata.
+ * Each koi_pool_t manages its own array over memory supplied by its owner. The koi_static_* functions use a default
+ * koi_pool_t over a static array of KOI_MEMORY_POOL_SIZE Blocks.
  */
 
 
@@ -33,34 +35,57 @@
 
 #ifdef __cplusplus
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #else
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #endif
 
+#if KOI_POOL_STATS && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 
 /**
  * Contains a pointer to allocated memory, if any, and metadata necessary for managing (de)allocations.
- * next: a pointer to the next memory block in the static memory pool. Should be either the next Block that has memory
+ * next: a pointer to the next memory block in the memory pool. Should be either the next Block that has memory
  * allocated, or the next free Block.
- * previous: a pointer to the previous memory block in the static memory pool. Should be either the previous Block that has
+ * previous: a pointer to the previous memory block in the memory pool. Should be either the previous Block that has
  * memory allocated, or the previous free Block.
  */
-typedef struct block_t {
-    struct block_t* next;
-    struct block_t* previous;
+typedef struct koi_block_t {
+    struct koi_block_t* next;
+    struct koi_block_t* previous;
     size_t index;
     size_t capacity;
     size_t size;
     char* data;
 } Block;
 
+/**
+ * Fails to compile if KOI_BLOCK_SIZE, which sizes the pool's members in the header, doesn't match the Block.
+ */
+typedef char block_size_check[(sizeof(Block) == KOI_BLOCK_SIZE) ? 1 : -1];
+
+
 
+/**
+ * Aligns a variable to KOI_POOL_ALIGNMENT, so koi_pool_init doesn't skip any of it. C99 has no keyword for it, and MSVC
+ * only takes a literal, which covers KOI_POOL_ALIGNMENT for pointers of up to 8 bytes.
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define KOI_POOL_ALIGNED _Alignas(KOI_POOL_ALIGNMENT)
+#elif defined(_MSC_VER)
+#define KOI_POOL_ALIGNED __declspec(align(16))
+typedef char pool_alignment_check[(16u % KOI_POOL_ALIGNMENT == 0u) ? 1 : -1];
+#else
+#define KOI_POOL_ALIGNED __attribute__((aligned(KOI_POOL_ALIGNMENT)))
+#endif
 
-static Block memory_pool[KOI_MEMORY_POOL_SIZE];
-static Block* free_list = NULL;
-static Block* start = NULL;
+static KOI_POOL_ALIGNED Block memory_pool[KOI_MEMORY_POOL_SIZE];
+static koi_pool_t default_pool;
 
 
 size_t koi_static_get_block_size(void) {
@@ -68,103 +93,552 @@ size_t koi_static_get_block_size(void) {
 }
 
 
-void koi_static_init(void) {
-    memory_pool[0u].next = NULL;
-    memory_pool[0u].previous = NULL;
-    memory_pool[0u].capacity = KOI_MEMORY_POOL_SIZE - 1u;
-    memory_pool[0u].index = 0u;
-    memory_pool[0u].size = 0u;
+#if KOI_FIT_POLICY == KOI_FIT_BEST
+/**
+ * The tree of free sections is a treap ordered by capacity, then index, so the smallest section big enough is also the
+ * earliest of its size. A free section keeps its tree links in its first data block, which is why sections with no
+ * data blocks are left out of the tree; they can't hold an allocation anyway.
+ */
+static Block** get_left(Block* node) {
+    return &node[1u].next;
+}
 
-    free_list = &memory_pool[0u];
-    start = &memory_pool[0u];
+
+static Block** get_right(Block* node) {
+    return &node[1u].previous;
 }
 
 
-void* koi_static_alloc(size_t size) {
-    // if the memory pool is full, fail
-    if (free_list == NULL || size == 0u) {
-        return NULL;
+/**
+ * Gets a node's heap priority, which is a hash of its index so the tree stays balanced in expectation without storing
+ * it. The hash is the splitmix64 finalizer, which mixes every bit of the index into every bit of the priority, so
+ * priorities don't follow the address order of the sections.
+ */
+static uint64_t get_priority(const Block* node) {
+    uint64_t hash = (uint64_t)node->index;
+
+    hash = (hash ^ (hash >> 30u)) * UINT64_C(0xbf58476d1ce4e5b9);
+    hash = (hash ^ (hash >> 27u)) * UINT64_C(0x94d049bb133111eb);
+
+    return hash ^ (hash >> 31u);
+}
+
+
+static int is_before(const Block* lhs, const Block* rhs) {
+    return lhs->capacity < rhs->capacity || (lhs->capacity == rhs->capacity && lhs->index < rhs->index);
+}
+
+
+/**
+ * Splits the given tree into the nodes before the given node and the nodes after it.
+ */
+static void tree_split(Block* tree, const Block* node, Block** before, Block** after) {
+    if (tree == NULL) {
+        *before = NULL;
+        *after = NULL;
+    } else if (is_before(tree, node)) {
+        *before = tree;
+        tree_split(*get_right(tree), node, get_right(tree), after);
+    } else {
+        *after = tree;
+        tree_split(*get_left(tree), node, before, get_left(tree));
     }
+}
 
-    // get the number of blocks needed, rounding the bytes needed up to the nearest division of sizeof(Block)
-    size_t blocks_needed = (size + sizeof(Block) - 1u) / sizeof(Block);
 
+/**
+ * Merges 2 trees, where every node of before comes before every node of after.
+ */
+static Block* tree_merge(Block* before, Block* after) {
+    if (before == NULL) {
+        return after;
+    }
+
+    if (after == NULL) {
+        return before;
+    }
+
+    if (get_priority(before) > get_priority(after)) {
+        *get_right(before) = tree_merge(*get_right(before), after);
+        return before;
+    }
+
+    *get_left(after) = tree_merge(before, *get_left(after));
+    return after;
+}
+
+
+static void tree_insert(Block** link, Block* node) {
+    while (*link != NULL && get_priority(*link) >= get_priority(node)) {
+        link = is_before(node, *link) ? get_left(*link) : get_right(*link);
+    }
+
+    tree_split(*link, node, get_left(node), get_right(node));
+    *link = node;
+}
+
+
+static void tree_remove(Block** link, const Block* node) {
+    while (*link != node) {
+        link = is_before(node, *link) ? get_left(*link) : get_right(*link);
+    }
+
+    *link = tree_merge(*get_left(*link), *get_right(*link));
+}
+
+
+/**
+ * Finds the first free section in the tree with at least the given capacity.
+ * @return The section, or NULL if none is big enough.
+ */
+static Block* tree_find(Block* tree, size_t capacity) {
+    Block* result = NULL;
+
+    while (tree != NULL) {
+        if (tree->capacity >= capacity) {
+            result = tree;
+            tree = *get_left(tree);
+        } else {
+            tree = *get_right(tree);
+        }
+    }
+
+    return result;
+}
+#endif
+
+
+/**
+ * Adds a free section to the index the fit policy searches, if it has one. Must be called whenever a free section is
+ * made or its capacity changes.
+ */
+static void index_free(koi_pool_t* pool, Block* section) {
+#if KOI_FIT_POLICY == KOI_FIT_BEST
+    if (section->capacity > 0u) {
+        tree_insert(&pool->free_tree, section);
+    }
+#else
+    (void)pool;
+    (void)section;
+#endif
+}
+
+
+/**
+ * Removes a free section from the index the fit policy searches, if it has one. Must be called before a free section
+ * is allocated, merged or its capacity changes.
+ */
+static void unindex_free(koi_pool_t* pool, Block* section) {
+#if KOI_FIT_POLICY == KOI_FIT_BEST
+    if (section->capacity > 0u) {
+        tree_remove(&pool->free_tree, section);
+    }
+#else
+    (void)pool;
+    (void)section;
+#endif
+}
+
+
+/**
+ * Called when a Block stops being part of the block chain because its section merged into the given one before it, so
+ * nothing keeps pointing at it.
+ */
+static void forget_block(koi_pool_t* pool, const Block* block, Block* merged_into) {
+#if KOI_FIT_POLICY == KOI_FIT_NEXT
+    if (pool->rover == block) {
+        pool->rover = merged_into;
+    }
+#else
+    (void)pool;
+    (void)block;
+    (void)merged_into;
+#endif
+}
+
+
+int koi_pool_init(koi_pool_t* pool, void* buffer, size_t bytes) {
+    if (pool == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    // skip the bytes at the front of the buffer that aren't aligned for a Block. KOI_POOL_ALIGNMENT is a multiple of the
+    // Block's alignment because sizeof(Block) is, and starting there makes every data block KOI_POOL_ALIGNMENT aligned
+    size_t padding = (KOI_POOL_ALIGNMENT - ((uintptr_t)buffer % KOI_POOL_ALIGNMENT)) % KOI_POOL_ALIGNMENT;
+
+    // a pool needs at least 1 Block to manage an allocation and 1 Block of data for it
+    if (bytes < padding || (bytes - padding) / sizeof(Block) < 2u) {
+        return 0;
+    }
+
+    pool->memory = (Block*)((char*)buffer + padding);
+    pool->block_count = (bytes - padding) / sizeof(Block);
+
+    pool->memory[0u].next = NULL;
+    pool->memory[0u].previous = NULL;
+    pool->memory[0u].capacity = pool->block_count - 1u;
+    pool->memory[0u].index = 0u;
+    pool->memory[0u].size = 0u;
+    pool->memory[0u].data = NULL;
+
+    pool->free_list = &pool->memory[0u];
+
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+    memset(pool->size_classes, 0, sizeof(pool->size_classes));
+#if KOI_SIZE_CLASS_FLUSH_THRESHOLD > 0u
+    pool->size_class_blocks = 0u;
+#endif
+#endif
+
+#if KOI_FIT_POLICY == KOI_FIT_NEXT
+    pool->rover = &pool->memory[0u];
+#elif KOI_FIT_POLICY == KOI_FIT_BEST
+    pool->free_tree = NULL;
+    index_free(pool, &pool->memory[0u]);
+#endif
+
+#if KOI_POOL_STATS
+    pool->bytes_held = 0u;
+    pool->high_water_mark = 0u;
+    pool->failure_count = 0u;
+    memset(pool->search_lengths, 0, sizeof(pool->search_lengths));
+#endif
+
+#if KOI_POOL_TRACE
+    pool->trace = NULL;
+    pool->trace_user_data = NULL;
+#endif
+
+    return 1;
+}
+
+
+#if KOI_POOL_TRACE
+void koi_pool_set_trace(koi_pool_t* pool, koi_trace_callback_t callback, void* user_data) {
+    pool->trace = callback;
+    pool->trace_user_data = user_data;
+}
+
+
+/**
+ * Reports an allocation, or a free if size is 0, to the memory pool's trace callback, if any.
+ */
+static void record_trace(const koi_pool_t* pool, size_t id, size_t size) {
+    if (pool->trace != NULL) {
+        pool->trace(pool->trace_user_data, id, size);
+    }
+}
+#endif
+
+
+#if KOI_POOL_STATS
+/**
+ * Records an allocation changing from the old to the new number of blocks, where 0 blocks means not allocated. Blocks
+ * parked in the size classes stay counted until they are flushed, so the size class fast paths record nothing.
+ */
+static void record_usage(koi_pool_t* pool, size_t old_blocks, size_t new_blocks) {
+    pool->bytes_held = pool->bytes_held - old_blocks * sizeof(Block) + new_blocks * sizeof(Block);
+
+    if (pool->bytes_held > pool->high_water_mark) {
+        pool->high_water_mark = pool->bytes_held;
+    }
+}
+
+
+/**
+ * Gets the index of the highest set bit of a non-zero word.
+ */
+static unsigned int find_last_set(size_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)(sizeof(unsigned long long) * 8u - 1u) - (unsigned int)__builtin_clzll((unsigned long long)word);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return (unsigned int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, (unsigned long)word);
+    return (unsigned int)index;
+#else
+    unsigned int index = 0u;
+    while ((word >>= 1u) != 0u) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+
+/**
+ * Records a search of the block chain that visited the given number of sections, at least 1.
+ */
+static void record_search(koi_pool_t* pool, size_t search_length) {
+    size_t bucket = find_last_set(search_length);
+    if (bucket > KOI_POOL_STATS_SEARCH_BUCKETS - 1u) {
+        bucket = KOI_POOL_STATS_SEARCH_BUCKETS - 1u;
+    }
+
+    ++pool->search_lengths[bucket];
+}
+#endif
+
+
+/**
+ * Gets the number of blocks to skip in the given free section so the data of an allocation starts aligned. Every data
+ * block is KOI_POOL_ALIGNMENT aligned and sizeof(Block) is an odd multiple of it, so this is less than
+ * alignment / KOI_POOL_ALIGNMENT.
+ * @return The number of blocks, or the section's capacity if the alignment can't be reached inside it.
+ */
+static size_t get_padding(const koi_pool_t* pool, const Block* section, size_t alignment) {
+    size_t padding = 0u;
+
+    while (padding < section->capacity
+           && (((uintptr_t)pool->memory + (section->index + padding + 1u) * sizeof(Block)) & (alignment - 1u)) != 0u) {
+        ++padding;
+    }
+
+    return padding;
+}
+
+
+/**
+ * Gets whether the given section is free and big enough for the number of blocks once its data is aligned.
+ * @param padding Set to the number of blocks to skip for the alignment.
+ */
+static int fits(const koi_pool_t* pool, const Block* section, size_t blocks_needed, size_t alignment, size_t* padding) {
+    // allocated sections have no capacity, so they never fit
+    *padding = alignment > KOI_POOL_ALIGNMENT ? get_padding(pool, section, alignment) : 0u;
+
+    return section->capacity >= *padding + blocks_needed;
+}
+
+
+/**
+ * Finds a free section for the given number of blocks, starting its data at the given alignment, with the fit policy.
+ * @param padding Set to the number of blocks to skip at the front of the section for the alignment.
+ * @return The section, or NULL if no section was big enough.
+ */
+static Block* find_fit(koi_pool_t* pool, size_t blocks_needed, size_t alignment, size_t* padding) {
+#if KOI_POOL_STATS
+    size_t search_length = 1u;
+#endif
+
+#if KOI_FIT_POLICY == KOI_FIT_BEST
+    // any section with room for the most padding the alignment can need fits, so 1 lookup is enough
+    size_t max_padding = alignment > KOI_POOL_ALIGNMENT ? alignment / KOI_POOL_ALIGNMENT - 1u : 0u;
+    Block* result = tree_find(pool->free_tree, blocks_needed + max_padding);
+
+    if (result != NULL) {
+        fits(pool, result, blocks_needed, alignment, padding);
+    }
+
+    // a smaller section might still fit with less padding than the most, so only then search every section in order
+    if (result == NULL && max_padding > 0u) {
+        result = pool->free_list;
+
+        while (result != NULL && !fits(pool, result, blocks_needed, alignment, padding)) {
+            result = result->next;
+#if KOI_POOL_STATS
+            ++search_length;
+#endif
+        }
+    }
+#elif KOI_FIT_POLICY == KOI_FIT_NEXT
+    // search from the rover to the end of the memory pool, then wrap around to its start and search up to the rover
+    Block* result = pool->rover;
+
+    while (!fits(pool, result, blocks_needed, alignment, padding)) {
+        result = result->next != NULL ? result->next : &pool->memory[0u];
+
+        if (result == pool->rover) {
+            result = NULL;
+            break;
+        }
+
+#if KOI_POOL_STATS
+        ++search_length;
+#endif
+    }
+#else
     // if there aren't enough blocks in this section of the memory pool, search for a section later in the memory pool to use
-    Block* result = free_list;
-    while (result != NULL && result->capacity < blocks_needed) {
+    Block* result = pool->free_list;
+
+    while (result != NULL && !fits(pool, result, blocks_needed, alignment, padding)) {
         result = result->next;
+#if KOI_POOL_STATS
+        ++search_length;
+#endif
+    }
+#endif
+
+#if KOI_POOL_STATS
+    record_search(pool, search_length);
+#endif
+
+    return result;
+}
+
+
+/**
+ * Allocates a section of the given number of blocks, found with the fit policy, that can start its data at the given
+ * alignment.
+ * @return The Block of the allocation, or NULL if no section was big enough.
+ */
+static Block* free_list_alloc(koi_pool_t* pool, size_t blocks_needed, size_t alignment) {
+    // if the memory pool is full, fail
+    if (pool->free_list == NULL) {
+        return NULL;
     }
 
-    // if there wasn't enough space later in the memory pool, fail
+    size_t padding = 0u;
+    Block* result = find_fit(pool, blocks_needed, alignment, &padding);
+
+    // if there wasn't a big enough section, fail
     if (result == NULL) {
         return NULL;
     }
 
-    size_t next_index = result->index + blocks_needed + 1u;
-    if (next_index < KOI_MEMORY_POOL_SIZE) {
-        Block *old_next = result->next;
-        Block *new_next = &memory_pool[next_index];
+    unindex_free(pool, result);
+
+    // if the data has to start later for its alignment, the skipped blocks stay behind as their own free section, which
+    // merges back when this allocation is freed
+    if (padding > 0u) {
+        Block* aligned = &pool->memory[result->index + padding];
 
-        // if there is some space after this allocation and before the next section (or the end of the memory pool)
-        if (new_next != NULL && new_next != old_next) {
-            new_next->index = next_index;
-            new_next->next = old_next;
-            result->next = new_next;
-            result->next->previous = result;
-            new_next->size = 0u;
-            new_next->capacity = result->capacity - new_next->index;
+        aligned->index = result->index + padding;
+        aligned->capacity = result->capacity - padding;
+        aligned->size = 0u;
+        aligned->data = NULL;
+        aligned->previous = result;
+        aligned->next = result->next;
+
+        if (aligned->next != NULL) {
+            aligned->next->previous = aligned;
         }
 
-        if (result == free_list) {
-            free_list = &memory_pool[result->index + blocks_needed + 1u];
+        result->next = aligned;
+        result->capacity = padding - 1u;
+        index_free(pool, result);
+        result = aligned;
+    }
+
+    // if there is some space after this allocation and before the next section (or the end of the memory pool),
+    // split it off into its own free section
+    if (result->capacity > blocks_needed) {
+        Block* old_next = result->next;
+        Block* new_next = &pool->memory[result->index + blocks_needed + 1u];
+
+        new_next->index = result->index + blocks_needed + 1u;
+        new_next->capacity = result->capacity - blocks_needed - 1u;
+        new_next->size = 0u;
+        new_next->data = NULL;
+        new_next->previous = result;
+        new_next->next = old_next;
+
+        if (old_next != NULL) {
+            old_next->previous = new_next;
         }
-    } else {
-        free_list = NULL;
+
+        result->next = new_next;
+        index_free(pool, new_next);
     }
 
     result->size = blocks_needed;
-    result->data = (char*)&memory_pool[result->index + 1u];
+    result->data = (char*)&pool->memory[result->index + 1u];
     result->capacity = 0u;
-    memset(result->data, '\0', size);
 
-    return result->data;
+#if KOI_FIT_POLICY == KOI_FIT_NEXT
+    pool->rover = result->next != NULL ? result->next : &pool->memory[0u];
+#endif
+
+    // if this was the earliest free section, move the free list up to the next free section
+    if (result == pool->free_list) {
+        pool->free_list = result->next;
+        while (pool->free_list != NULL && pool->free_list->size > 0u) {
+            pool->free_list = pool->free_list->next;
+        }
+    }
+
+    return result;
 }
 
 
-void* koi_static_free(void* ptr) {
-    if (ptr == NULL) {
+/**
+ * Gets the Block that manages the given pointer. Every allocation's data starts at the Block right after its own,
+ * so no search is needed. The Block's own index and the section before it are checked too, so data inside another
+ * allocation isn't taken for a Block.
+ * @return The Block, or NULL if ptr doesn't point at the data of an allocation in the memory pool.
+ */
+static Block* get_block(const koi_pool_t* pool, void* ptr) {
+    Block* data = (Block*)ptr;
+
+    if (data <= pool->memory || data >= pool->memory + pool->block_count) {
         return NULL;
     }
 
-    Block* block = start;
-    while (block && block->data != ptr) {
-        block = block->next;
+    // a pointer between Blocks can't be an allocation's data, and its Block would be misaligned
+    if (((uintptr_t)ptr - (uintptr_t)pool->memory) % sizeof(Block) != 0u) {
+        return NULL;
     }
 
-    if (block->next == NULL && block->previous == NULL) {
-        block->capacity = block->size;
-        block->size = 0u;
-        free_list = block;
+    Block* block = data - 1;
+    if (block->data != (char*)ptr || block->size == 0u || block->index != (size_t)(block - pool->memory)) {
         return NULL;
     }
 
+    // the Block might be allocated data that only looks like a header, so the section before it must link to it too
+    Block* previous = block->previous;
+    if (previous == NULL) {
+        return block == pool->memory ? block : NULL;
+    }
+
+    if (previous < pool->memory || previous >= block
+            || ((uintptr_t)previous - (uintptr_t)pool->memory) % sizeof(Block) != 0u || previous->next != block) {
+        return NULL;
+    }
+
+    return block;
+}
+
+
+/**
+ * Frees the section of the given allocated Block, merging it with its free neighbours.
+ */
+static void free_list_free(koi_pool_t* pool, Block* block) {
     size_t new_capacity = block->size;
 
     // if the next block has free space, merge this block with it for a contiguous section
-    if (block->next != NULL && block->next->capacity > 0u) {
+    if (block->next != NULL && block->next->size == 0u) {
+        unindex_free(pool, block->next);
+        forget_block(pool, block->next, block);
+
         // add the next block's capacity, +1 because we can use the next block as part of the next memory allocation
         new_capacity += block->next->capacity + 1u;
         block->next = block->next->next;
+
+        if (block->next != NULL) {
+            block->next->previous = block;
+        }
     }
 
     // if the previous block has free space, merge it with this block as well
-    if (block->previous != NULL && block->previous->capacity > 0u) {
+    if (block->previous != NULL && block->previous->size == 0u) {
         Block *previous = block->previous;
+        unindex_free(pool, previous);
+        forget_block(pool, block, previous);
 
         // add the previous block's capacity, +1 because we can use this block as part of the next memory allocation
         new_capacity += previous->capacity + 1u;
 
         previous->next = block->next;
+
+        if (previous->next != NULL) {
+            previous->next->previous = previous;
+        }
+
+        // this block is now part of the previous section's data, so make sure it can't be freed again
+        block->size = 0u;
+        block->data = NULL;
         block = previous;
     }
 
@@ -172,11 +646,551 @@ void* koi_static_free(void* ptr) {
     block->capacity = new_capacity;
     block->size = 0u;
     block->data = NULL;
+    index_free(pool, block);
 
     // update the free list to be the earliest in the memory pool
-    if (free_list == NULL || block->index < free_list->index) {
-        free_list = block;
+    if (pool->free_list == NULL || block->index < pool->free_list->index) {
+        pool->free_list = block;
     }
+}
+
+
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+/**
+ * Gets whether a freed allocation of the given number of blocks can be parked in its size class. With a flush
+ * threshold, only while the size classes stay within it, so a free past it merges just its own allocation instead of
+ * every parked one, and the parked allocations stay ready for reuse.
+ */
+static int can_park(const koi_pool_t* pool, size_t blocks) {
+#if KOI_SIZE_CLASS_FLUSH_THRESHOLD > 0u
+    return blocks <= KOI_SIZE_CLASS_COUNT
+           && (pool->size_class_blocks + blocks) * sizeof(Block) <= KOI_SIZE_CLASS_FLUSH_THRESHOLD;
+#else
+    (void)pool;
+    return blocks <= KOI_SIZE_CLASS_COUNT;
+#endif
+}
+
+
+/**
+ * Returns every Block parked in the size classes to the block chain so they can merge into bigger sections.
+ * @return Whether any Block was returned.
+ */
+static int flush_size_classes(koi_pool_t* pool) {
+    int result = 0;
+
+    for (size_t i = 0u; i < KOI_SIZE_CLASS_COUNT; ++i) {
+        while (pool->size_classes[i] != NULL) {
+            Block* block = pool->size_classes[i];
+            pool->size_classes[i] = block[1u].next;
+
+#if KOI_POOL_STATS
+            record_usage(pool, block->size, 0u);
+#endif
+
+            free_list_free(pool, block);
+            result = 1;
+        }
+    }
+
+#if KOI_SIZE_CLASS_FLUSH_THRESHOLD > 0u
+    pool->size_class_blocks = 0u;
+#endif
+
+    return result;
+}
+#endif
+
+
+void* koi_pool_alloc(koi_pool_t* pool, size_t size) {
+    return koi_pool_alloc_aligned(pool, size, KOI_POOL_ALIGNMENT);
+}
+
+
+void* koi_pool_alloc_aligned(koi_pool_t* pool, size_t size, size_t alignment) {
+    if (size == 0u || alignment == 0u || (alignment & (alignment - 1u)) != 0u) {
+        return NULL;
+    }
+
+    // nothing bigger than the whole memory pool can fit, and checking first keeps the rounding below from wrapping
+    if (size > (pool->block_count - 1u) * sizeof(Block)) {
+        return NULL;
+    }
+
+    // get the number of blocks needed, rounding the bytes needed up to the nearest division of sizeof(Block)
+    size_t blocks_needed = (size + sizeof(Block) - 1u) / sizeof(Block);
+
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+    // small allocations reuse a freed allocation of the same size class, if any. They're only KOI_POOL_ALIGNMENT aligned
+    if (alignment <= KOI_POOL_ALIGNMENT && blocks_needed <= KOI_SIZE_CLASS_COUNT
+        && pool->size_classes[blocks_needed - 1u] != NULL) {
+        Block* result = pool->size_classes[blocks_needed - 1u];
+        pool->size_classes[blocks_needed - 1u] = result[1u].next;
+        result->data = (char*)&result[1u];
+#if KOI_SIZE_CLASS_FLUSH_THRESHOLD > 0u
+        pool->size_class_blocks -= blocks_needed;
+#endif
+#if KOI_POOL_TRACE
+        record_trace(pool, result->index, size);
+#endif
+        return result->data;
+    }
+#endif
+
+    Block* result = free_list_alloc(pool, blocks_needed, alignment);
+
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+    // the size classes might be holding on to enough memory, so give it back and try again
+    if (result == NULL && flush_size_classes(pool)) {
+        result = free_list_alloc(pool, blocks_needed, alignment);
+    }
+#endif
+
+    if (result == NULL) {
+#if KOI_POOL_STATS
+        ++pool->failure_count;
+#endif
+        return NULL;
+    }
+
+#if KOI_POOL_STATS
+    record_usage(pool, 0u, result->size);
+#endif
+
+#if KOI_POOL_TRACE
+    record_trace(pool, result->index, size);
+#endif
+
+    return result->data;
+}
+
+
+void* koi_pool_calloc(koi_pool_t* pool, size_t count, size_t size) {
+    if (size != 0u && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void* result = koi_pool_alloc(pool, count * size);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    memset(result, '\0', count * size);
+
+    return result;
+}
+
+
+void* koi_pool_free(koi_pool_t* pool, void* ptr) {
+    if (ptr == NULL) {
+        return NULL;
+    }
+
+    Block* block = get_block(pool, ptr);
+    if (block == NULL) {
+        return NULL;
+    }
+
+#if KOI_POOL_TRACE
+    record_trace(pool, block->index, 0u);
+#endif
+
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+    // small allocations are parked in their size class instead of merging, clearing data so they can't be freed twice
+    if (can_park(pool, block->size)) {
+        block[1u].next = pool->size_classes[block->size - 1u];
+        pool->size_classes[block->size - 1u] = block;
+        block->data = NULL;
+
+#if KOI_SIZE_CLASS_FLUSH_THRESHOLD > 0u
+        pool->size_class_blocks += block->size;
+#endif
+
+        return NULL;
+    }
+#endif
+
+#if KOI_POOL_STATS
+    record_usage(pool, block->size, 0u);
+#endif
+
+    free_list_free(pool, block);
 
     return NULL;
 }
+
+
+int koi_pool_alloc_batch(koi_pool_t* pool, size_t size, size_t count, void** out_ptrs) {
+    if (size == 0u || count == 0u || size > (pool->block_count - 1u) * sizeof(Block)) {
+        return 0;
+    }
+
+    // every allocation after the first needs its own Block header inside the section
+    size_t blocks_needed = (size + sizeof(Block) - 1u) / sizeof(Block);
+    if (blocks_needed + 1u > SIZE_MAX / count) {
+        return 0;
+    }
+
+    size_t section_blocks = count * (blocks_needed + 1u) - 1u;
+    Block* section = free_list_alloc(pool, section_blocks, KOI_POOL_ALIGNMENT);
+
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+    if (section == NULL && flush_size_classes(pool)) {
+        section = free_list_alloc(pool, section_blocks, KOI_POOL_ALIGNMENT);
+    }
+#endif
+
+    if (section == NULL) {
+#if KOI_POOL_STATS
+        ++pool->failure_count;
+#endif
+        return 0;
+    }
+
+    // split the section into the allocations, linking each into the block chain after the one before it
+    Block* previous = section->previous;
+    Block* next = section->next;
+
+    for (size_t i = 0u; i < count; ++i) {
+        Block* block = section + i * (blocks_needed + 1u);
+
+        block->index = section->index + i * (blocks_needed + 1u);
+        block->capacity = 0u;
+        block->size = blocks_needed;
+        block->data = (char*)&block[1u];
+        block->previous = previous;
+
+        if (previous != NULL) {
+            previous->next = block;
+        }
+
+        previous = block;
+        out_ptrs[i] = block->data;
+
+#if KOI_POOL_TRACE
+        record_trace(pool, block->index, size);
+#endif
+    }
+
+    previous->next = next;
+    if (next != NULL) {
+        next->previous = previous;
+    }
+
+#if KOI_POOL_STATS
+    record_usage(pool, 0u, count * blocks_needed);
+#endif
+
+    return 1;
+}
+
+
+/**
+ * Orders pointers by address for qsort.
+ */
+static int compare_addresses(const void* lhs, const void* rhs) {
+    uintptr_t lhs_address = (uintptr_t)*(void* const*)lhs;
+    uintptr_t rhs_address = (uintptr_t)*(void* const*)rhs;
+
+    return (lhs_address > rhs_address) - (lhs_address < rhs_address);
+}
+
+
+void koi_pool_free_batch(koi_pool_t* pool, void** ptrs, size_t count) {
+    if (ptrs == NULL || count == 0u) {
+        return;
+    }
+
+    // batches from koi_pool_alloc_batch are already in address order, so only sort when needed
+    size_t i = 1u;
+    while (i < count && (uintptr_t)ptrs[i - 1u] <= (uintptr_t)ptrs[i]) {
+        ++i;
+    }
+
+    if (i < count) {
+        qsort(ptrs, count, sizeof(void*), compare_addresses);
+    }
+
+    i = 0u;
+    while (i < count) {
+        Block* first = (i > 0u && ptrs[i] == ptrs[i - 1u]) ? NULL : get_block(pool, ptrs[i]);
+        ++i;
+
+        if (first == NULL) {
+            continue;
+        }
+
+#if KOI_POOL_STATS
+        record_usage(pool, first->size, 0u);
+#endif
+
+#if KOI_POOL_TRACE
+        record_trace(pool, first->index, 0u);
+#endif
+
+        // absorb the following allocations of the batch while they're next in the block chain, +1 for each header
+        Block* last = first;
+        while (i < count) {
+            Block* block = ptrs[i] == ptrs[i - 1u] ? NULL : get_block(pool, ptrs[i]);
+
+            if (block != NULL && block != last->next) {
+                break;
+            }
+
+            ++i;
+
+            if (block == NULL) {
+                continue;
+            }
+
+#if KOI_POOL_STATS
+            record_usage(pool, block->size, 0u);
+#endif
+
+#if KOI_POOL_TRACE
+            record_trace(pool, block->index, 0u);
+#endif
+
+            forget_block(pool, block, first);
+
+            first->size += block->size + 1u;
+            block->size = 0u;
+            block->data = NULL;
+            last = block;
+        }
+
+        first->next = last->next;
+        if (first->next != NULL) {
+            first->next->previous = first;
+        }
+
+        // the run frees as 1 allocation, merging with the free sections on either side
+        free_list_free(pool, first);
+    }
+}
+
+
+/**
+ * Frees the blocks of the given allocated Block past the given number of blocks, merging them with the next section if
+ * it is free.
+ */
+static void split_tail(koi_pool_t* pool, Block* block, size_t blocks_needed) {
+    Block* tail = &pool->memory[block->index + blocks_needed + 1u];
+
+    // the tail starts as an allocation of the blocks left over, -1 for its own header, so it frees like any other
+    tail->index = block->index + blocks_needed + 1u;
+    tail->capacity = 0u;
+    tail->size = block->size - blocks_needed - 1u;
+    tail->data = NULL;
+    tail->previous = block;
+    tail->next = block->next;
+
+    if (tail->next != NULL) {
+        tail->next->previous = tail;
+    }
+
+    block->next = tail;
+    block->size = blocks_needed;
+
+    free_list_free(pool, tail);
+}
+
+
+/**
+ * Resizes the given allocated Block to the given number of blocks without moving it, if its next section has room.
+ * @return Whether the Block was resized.
+ */
+static int resize_in_place(koi_pool_t* pool, Block* block, size_t blocks_needed) {
+    // shrink in place, giving back the blocks no longer needed
+    if (blocks_needed < block->size) {
+        split_tail(pool, block, blocks_needed);
+        return 1;
+    }
+
+    if (blocks_needed == block->size) {
+        return 1;
+    }
+
+    // grow in place by taking over the next section if it is free and big enough, +1 for its header
+    Block* next = block->next;
+    if (next == NULL || next->size > 0u || block->size + next->capacity + 1u < blocks_needed) {
+        return 0;
+    }
+
+    unindex_free(pool, next);
+    forget_block(pool, next, block);
+
+    block->size += next->capacity + 1u;
+    block->next = next->next;
+
+    if (block->next != NULL) {
+        block->next->previous = block;
+    }
+
+    // if the next section was the earliest free one, move the free list up to the next free section
+    if (pool->free_list == next) {
+        pool->free_list = block->next;
+        while (pool->free_list != NULL && pool->free_list->size > 0u) {
+            pool->free_list = pool->free_list->next;
+        }
+    }
+
+    next->capacity = 0u;
+
+    if (block->size > blocks_needed) {
+        split_tail(pool, block, blocks_needed);
+    }
+
+    return 1;
+}
+
+
+void* koi_pool_realloc(koi_pool_t* pool, void* ptr, size_t size) {
+    if (ptr == NULL) {
+        return koi_pool_alloc(pool, size);
+    }
+
+    Block* block = get_block(pool, ptr);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    if (size == 0u) {
+        return koi_pool_free(pool, ptr);
+    }
+
+    if (size > (pool->block_count - 1u) * sizeof(Block)) {
+        return NULL;
+    }
+
+    size_t blocks_needed = (size + sizeof(Block) - 1u) / sizeof(Block);
+    size_t old_blocks = block->size;
+
+    if (resize_in_place(pool, block, blocks_needed)) {
+#if KOI_POOL_STATS
+        record_usage(pool, old_blocks, blocks_needed);
+#endif
+#if KOI_POOL_TRACE
+        record_trace(pool, block->index, 0u);
+        record_trace(pool, block->index, size);
+#endif
+        return ptr;
+    }
+
+    // otherwise, move to a new section, leaving the allocation untouched if there isn't one
+    void* result = koi_pool_alloc(pool, size);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    memcpy(result, ptr, old_blocks * sizeof(Block));
+    koi_pool_free(pool, ptr);
+
+    return result;
+}
+
+
+size_t koi_pool_get_size(const koi_pool_t* pool, void* ptr) {
+    if (ptr == NULL) {
+        return 0u;
+    }
+
+    Block* block = get_block(pool, ptr);
+    if (block == NULL) {
+        return 0u;
+    }
+
+    return block->size * sizeof(Block);
+}
+
+
+void koi_pool_get_stats(const koi_pool_t* pool, koi_pool_stats_t* stats) {
+    memset(stats, 0, sizeof(koi_pool_stats_t));
+
+    for (const Block* block = pool->memory; block != NULL; block = block->next) {
+        if (block->size > 0u) {
+            stats->bytes_in_use += block->size * sizeof(Block);
+            continue;
+        }
+
+        stats->free_bytes += block->capacity * sizeof(Block);
+        ++stats->free_segments;
+
+        if (block->capacity * sizeof(Block) > stats->largest_free_segment) {
+            stats->largest_free_segment = block->capacity * sizeof(Block);
+        }
+    }
+
+#if KOI_SIZE_CLASS_MAX_SIZE > 0u
+    // parked allocations are still in the block chain, but aren't in use
+    for (size_t i = 0u; i < KOI_SIZE_CLASS_COUNT; ++i) {
+        for (const Block* block = pool->size_classes[i]; block != NULL; block = block[1u].next) {
+            stats->size_class_bytes += block->size * sizeof(Block);
+        }
+    }
+
+    stats->bytes_in_use -= stats->size_class_bytes;
+#endif
+
+    if (stats->free_bytes > 0u) {
+        stats->fragmentation = 1.0 - (double)stats->largest_free_segment / (double)stats->free_bytes;
+    }
+
+#if KOI_POOL_STATS
+    stats->high_water_mark = pool->high_water_mark;
+    stats->failure_count = pool->failure_count;
+    memcpy(stats->search_lengths, pool->search_lengths, sizeof(stats->search_lengths));
+#endif
+}
+
+
+void koi_static_init(void) {
+    koi_pool_init(&default_pool, memory_pool, sizeof(memory_pool));
+}
+
+
+void* koi_static_alloc(size_t size) {
+    return koi_pool_alloc(&default_pool, size);
+}
+
+
+void* koi_static_calloc(size_t count, size_t size) {
+    return koi_pool_calloc(&default_pool, count, size);
+}
+
+
+void* koi_static_alloc_aligned(size_t size, size_t alignment) {
+    return koi_pool_alloc_aligned(&default_pool, size, alignment);
+}
+
+
+void* koi_static_realloc(void* ptr, size_t size) {
+    return koi_pool_realloc(&default_pool, ptr, size);
+}
+
+
+#if KOI_POOL_TRACE
+void koi_static_set_trace(koi_trace_callback_t callback, void* user_data) {
+    koi_pool_set_trace(&default_pool, callback, user_data);
+}
+#endif
+
+
+void koi_static_get_stats(koi_pool_stats_t* stats) {
+    koi_pool_get_stats(&default_pool, stats);
+}
+
+
+void* koi_static_free(void* ptr) {
+    return koi_pool_free(&default_pool, ptr);
+}
+
+
+int koi_static_alloc_batch(size_t size, size_t count, void** out_ptrs) {
+    return koi_pool_alloc_batch(&default_pool, size, count, out_ptrs);
+}
+
+
+void koi_static_free_batch(void** ptrs, size_t count) {
+    koi_pool_free_batch(&default_pool, ptrs, count);
+}
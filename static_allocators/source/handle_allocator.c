@@ -0,0 +1,252 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * A compacting allocator whose allocations are referenced by generational handles. A handle's entry in the handle
+ * table holds its allocation's current address, so compaction can move the allocation and update only the entry.
+ * Each allocation starts with a Header that holds its size and its entry's index, so compaction can walk the heap
+ * from allocation to allocation and find the entry of each one it moves.
+ */
+
+
+#include "static_allocators/handle_allocator.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+
+/**
+ * An entry of the handle table.
+ * data: the first byte of the allocation, or NULL if the entry is unused.
+ * generation: the generation of the handle currently, or next, using this entry. Never 0, so KOI_HANDLE_NULL never
+ * resolves.
+ * next_free: the index of the next unused entry, while this one is unused.
+ */
+typedef struct koi_handle_entry_t {
+    char* data;
+    uint32_t generation;
+    uint32_t next_free;
+} Entry;
+
+/**
+ * The start of every allocation in the heap, and of every hole left by a freed one.
+ * size: the number of bytes of the allocation including this Header.
+ * index: the index of the allocation's entry, or KOI_HANDLE_FREE_INDEX for a hole.
+ */
+typedef struct {
+    size_t size;
+    size_t index;
+} Header;
+
+/**
+ * Fails to compile if a Header would break the alignment of the data after it.
+ */
+typedef char header_size_check[(sizeof(Header) == KOI_HANDLE_ALIGNMENT) ? 1 : -1];
+
+/**
+ * The index of a Header of a hole.
+ */
+#define KOI_HANDLE_FREE_INDEX SIZE_MAX
+
+/**
+ * The mask of the bits of a generation.
+ */
+#define KOI_HANDLE_GENERATION_MASK ((uint32_t)0xFFFFFFFFu >> KOI_HANDLE_INDEX_BITS)
+
+
+int koi_handle_pool_init(koi_handle_pool_t* pool, void* buffer, size_t bytes, uint32_t handle_count) {
+    if (pool == NULL || buffer == NULL || handle_count == 0u || handle_count > KOI_HANDLE_MAX_COUNT) {
+        return 0;
+    }
+
+    // skip the bytes at the front of the buffer that aren't aligned, and keep the heap after the table aligned
+    size_t padding = (KOI_HANDLE_ALIGNMENT - ((uintptr_t)buffer % KOI_HANDLE_ALIGNMENT)) % KOI_HANDLE_ALIGNMENT;
+    size_t table_bytes = ((size_t)handle_count * sizeof(Entry) + KOI_HANDLE_ALIGNMENT - 1u)
+            & ~(KOI_HANDLE_ALIGNMENT - 1u);
+
+    if (bytes < padding || bytes - padding <= table_bytes) {
+        return 0;
+    }
+
+    pool->entries = (Entry*)((char*)buffer + padding);
+    pool->entry_count = handle_count;
+    pool->free_entry = 0u;
+    pool->heap = (char*)pool->entries + table_bytes;
+    pool->heap_bytes = (bytes - padding - table_bytes) & ~(KOI_HANDLE_ALIGNMENT - 1u);
+    pool->top = 0u;
+    pool->hole_bytes = 0u;
+    pool->compact_end = 0u;
+    pool->compact_scan = 0u;
+
+    for (uint32_t i = 0u; i < handle_count; ++i) {
+        pool->entries[i].data = NULL;
+        pool->entries[i].generation = 1u;
+        pool->entries[i].next_free = i + 1u;
+    }
+
+    return 1;
+}
+
+
+koi_handle_t koi_handle_alloc(koi_handle_pool_t* pool, size_t size) {
+    if (size == 0u || size > pool->heap_bytes || pool->free_entry == pool->entry_count) {
+        return KOI_HANDLE_NULL;
+    }
+
+    // +1 Header, rounding the data up so the next allocation stays aligned
+    size_t total = sizeof(Header) + ((size + KOI_HANDLE_ALIGNMENT - 1u) & ~(KOI_HANDLE_ALIGNMENT - 1u));
+    if (pool->heap_bytes - pool->top < total) {
+        return KOI_HANDLE_NULL;
+    }
+
+    uint32_t index = pool->free_entry;
+    Entry* entry = &pool->entries[index];
+    Header* header = (Header*)(pool->heap + pool->top);
+
+    header->size = total;
+    header->index = index;
+
+    pool->free_entry = entry->next_free;
+    entry->data = (char*)(header + 1);
+    pool->top += total;
+
+    return (koi_handle_t)((entry->generation << KOI_HANDLE_INDEX_BITS) | index);
+}
+
+
+/**
+ * Gets the entry of the given handle.
+ * @return The entry, or NULL if the handle doesn't resolve.
+ */
+static Entry* get_entry(const koi_handle_pool_t* pool, koi_handle_t handle) {
+    uint32_t index = handle & (KOI_HANDLE_MAX_COUNT - 1u);
+
+    if (index >= pool->entry_count) {
+        return NULL;
+    }
+
+    Entry* entry = &pool->entries[index];
+    if (entry->data == NULL || entry->generation != (handle >> KOI_HANDLE_INDEX_BITS)) {
+        return NULL;
+    }
+
+    return entry;
+}
+
+
+void koi_handle_free(koi_handle_pool_t* pool, koi_handle_t handle) {
+    Entry* entry = get_entry(pool, handle);
+    if (entry == NULL) {
+        return;
+    }
+
+    Header* header = (Header*)entry->data - 1;
+    size_t offset = (size_t)((char*)header - pool->heap);
+
+    header->index = KOI_HANDLE_FREE_INDEX;
+
+    // the last allocation gives its bytes straight back to the top, anything else leaves a hole for compaction
+    if (offset + header->size == pool->top) {
+        pool->top = offset;
+    } else {
+        pool->hole_bytes += header->size;
+    }
+
+    // bump the generation, skipping 0, so this handle never resolves again
+    entry->generation = (entry->generation + 1u) & KOI_HANDLE_GENERATION_MASK;
+    if (entry->generation == 0u) {
+        entry->generation = 1u;
+    }
+
+    entry->data = NULL;
+    entry->next_free = pool->free_entry;
+    pool->free_entry = (uint32_t)(entry - pool->entries);
+}
+
+
+void* koi_handle_get(const koi_handle_pool_t* pool, koi_handle_t handle) {
+    Entry* entry = get_entry(pool, handle);
+    return entry == NULL ? NULL : entry->data;
+}
+
+
+int koi_handle_compact(koi_handle_pool_t* pool, size_t byte_budget) {
+    if (pool->hole_bytes == 0u) {
+        pool->compact_end = 0u;
+        pool->compact_scan = 0u;
+        return 1;
+    }
+
+    size_t spent = 0u;
+
+    // slide each live allocation down to the end of the compacted part, skipping holes
+    do {
+        if (pool->compact_scan >= pool->top) {
+            break;
+        }
+
+        Header* header = (Header*)(pool->heap + pool->compact_scan);
+        size_t size = header->size;
+
+        if (header->index == KOI_HANDLE_FREE_INDEX) {
+            spent += sizeof(Header);
+        } else {
+            if (pool->compact_end != pool->compact_scan) {
+                memmove(pool->heap + pool->compact_end, header, size);
+                pool->entries[header->index].data = pool->heap + pool->compact_end + sizeof(Header);
+            }
+
+            pool->compact_end += size;
+            spent += size;
+        }
+
+        pool->compact_scan += size;
+    } while (spent < byte_budget);
+
+    if (pool->compact_scan < pool->top) {
+        return 0;
+    }
+
+    // the pass is done, so everything between the compacted part and the old top is free again. Holes left by frees
+    // behind compact_end during the pass are left for the next pass
+    pool->hole_bytes -= pool->top - pool->compact_end;
+    pool->top = pool->compact_end;
+    pool->compact_end = 0u;
+    pool->compact_scan = 0u;
+
+    return pool->hole_bytes == 0u;
+}
+
+
+size_t koi_handle_get_available(const koi_handle_pool_t* pool) {
+    return pool->heap_bytes - pool->top;
+}
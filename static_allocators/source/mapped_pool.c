@@ -0,0 +1,160 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * Memory pools over memory mapped from the OS. The pool itself is the free list allocator; this only gets its memory
+ * and gives it back.
+ */
+
+
+// MAP_ANONYMOUS and madvise are POSIX extensions hidden by a strict C99 build
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "static_allocators/mapped_pool.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ * The size of a transparent huge page on the platforms that have them. A mapping must be aligned to it for its pages
+ * to be promoted.
+ */
+#define KOI_HUGE_PAGE_SIZE ((size_t)2u * 1024u * 1024u)
+
+
+#ifdef _WIN32
+static void* map_memory(size_t* bytes, unsigned int flags) {
+    (void)flags;
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    size_t page_size = (size_t)info.dwAllocationGranularity;
+    if (*bytes > SIZE_MAX - page_size) {
+        return NULL;
+    }
+
+    *bytes = (*bytes + page_size - 1u) / page_size * page_size;
+
+    return VirtualAlloc(NULL, *bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+
+static void unmap_memory(void* memory, size_t bytes) {
+    (void)bytes;
+    VirtualFree(memory, 0u, MEM_RELEASE);
+}
+#else
+static void* map_memory(size_t* bytes, unsigned int flags) {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t alignment = (flags & KOI_POOL_MAP_HUGE_PAGES) != 0u ? KOI_HUGE_PAGE_SIZE : page_size;
+
+    if (*bytes > SIZE_MAX - 2u * alignment) {
+        return NULL;
+    }
+
+    *bytes = (*bytes + alignment - 1u) / alignment * alignment;
+
+    // reserve enough extra to align the start, then give the unaligned ends back
+    size_t reserved = *bytes + alignment - page_size;
+    int map_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    map_flags |= MAP_NORESERVE;
+#endif
+
+    char* mapping = (char*)mmap(NULL, reserved, PROT_READ | PROT_WRITE, map_flags, -1, 0);
+    if (mapping == (char*)MAP_FAILED) {
+        return NULL;
+    }
+
+    size_t head = (alignment - ((uintptr_t)mapping % alignment)) % alignment;
+    size_t tail = reserved - head - *bytes;
+
+    if (head > 0u) {
+        munmap(mapping, head);
+    }
+
+    if (tail > 0u) {
+        munmap(mapping + head + *bytes, tail);
+    }
+
+#ifdef MADV_HUGEPAGE
+    if ((flags & KOI_POOL_MAP_HUGE_PAGES) != 0u) {
+        // only advice, so a kernel without transparent huge pages still gets a working pool
+        madvise(mapping + head, *bytes, MADV_HUGEPAGE);
+    }
+#endif
+
+    return mapping + head;
+}
+
+
+static void unmap_memory(void* memory, size_t bytes) {
+    munmap(memory, bytes);
+}
+#endif
+
+
+int koi_pool_map(koi_pool_t* pool, size_t bytes, unsigned int flags) {
+    if (pool == NULL || bytes == 0u) {
+        return 0;
+    }
+
+    void* memory = map_memory(&bytes, flags);
+    if (memory == NULL) {
+        return 0;
+    }
+
+    // pages are page aligned, so the pool starts at the mapping and koi_pool_unmap can find it again
+    if (!koi_pool_init(pool, memory, bytes)) {
+        unmap_memory(memory, bytes);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+void koi_pool_unmap(koi_pool_t* pool) {
+    // the last Block ends less than a Block before the end of the mapping, so this covers every page of it
+    unmap_memory(pool->memory, pool->block_count * koi_static_get_block_size());
+
+    pool->memory = NULL;
+    pool->block_count = 0u;
+    pool->free_list = NULL;
+}
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/remote_free_pool.hpp"
+
+
+namespace Koi {
+
+RemoteFreePool::RemoteFreePool(): _pool(), _owner(), _remote_frees(nullptr) {
+}
+
+
+bool RemoteFreePool::init(void* buffer, size_t bytes) {
+    _owner = std::this_thread::get_id();
+    _remote_frees.store(nullptr, std::memory_order_relaxed);
+
+    return koi_pool_init(&_pool, buffer, bytes) == 1;
+}
+
+
+void* RemoteFreePool::alloc(size_t size) {
+    // only pay for the exchange when another thread freed something
+    if (_remote_frees.load(std::memory_order_relaxed) != nullptr) {
+        drain();
+    }
+
+    return koi_pool_alloc(&_pool, size);
+}
+
+
+void* RemoteFreePool::free(void* ptr) {
+    if (ptr == nullptr) {
+        return nullptr;
+    }
+
+    if (std::this_thread::get_id() == _owner) {
+        return koi_pool_free(&_pool, ptr);
+    }
+
+    // the link is written over the pointed at memory, so pointers outside the pool must be turned away first. Only
+    // init writes the pool's bounds, so reading them here doesn't race with the owner
+    const char* memory = reinterpret_cast<const char*>(_pool.memory);
+    const char* address = static_cast<const char*>(ptr);
+    if (address < memory || address >= memory + _pool.block_count * KOI_BLOCK_SIZE) {
+        return nullptr;
+    }
+
+    // every allocation is at least a block, so there is room for the link. The release publishes it, and every write
+    // the freeing thread made before, to the owner's acquire in drain
+    RemoteFree* remote_free = static_cast<RemoteFree*>(ptr);
+    remote_free->next = _remote_frees.load(std::memory_order_relaxed);
+
+    while (!_remote_frees.compare_exchange_weak(remote_free->next, remote_free, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+    }
+
+    return nullptr;
+}
+
+
+void RemoteFreePool::drain() {
+    // only the owner takes from the list, and it takes the whole list at once, so there is no ABA problem
+    RemoteFree* remote_free = _remote_frees.exchange(nullptr, std::memory_order_acquire);
+
+    while (remote_free != nullptr) {
+        RemoteFree* next = remote_free->next;
+        koi_pool_free(&_pool, remote_free);
+        remote_free = next;
+    }
+}
+
+
+const koi_pool_t* RemoteFreePool::get_pool() const {
+    return &_pool;
+}
+
+} // Koi
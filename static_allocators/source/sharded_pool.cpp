@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/sharded_pool.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+
+namespace Koi {
+
+ShardedPool::ShardedPool(): _shards(), _shard_count(0u), _shard_bytes(0u), _memory(nullptr) {
+}
+
+
+bool ShardedPool::init(void* buffer, size_t bytes, size_t shard_count) {
+    if (shard_count == 0u) {
+        shard_count = std::thread::hardware_concurrency();
+        shard_count = shard_count == 0u ? 1u : shard_count;
+        shard_count = shard_count > KOI_SHARDED_POOL_MAX_SHARDS ? KOI_SHARDED_POOL_MAX_SHARDS : shard_count;
+    }
+
+    if (buffer == nullptr || shard_count > KOI_SHARDED_POOL_MAX_SHARDS) {
+        return false;
+    }
+
+    // whole blocks per shard keep every shard's blocks aligned the same way, and the few bytes left over go unused
+    _memory = static_cast<char*>(buffer);
+    _shard_count = shard_count;
+    _shard_bytes = bytes / shard_count / KOI_BLOCK_SIZE * KOI_BLOCK_SIZE;
+
+    for (size_t i = 0u; i < _shard_count; ++i) {
+        if (koi_pool_init(&_shards[i].pool, _memory + i * _shard_bytes, _shard_bytes) != 1) {
+            _shard_count = 0u;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void* ShardedPool::alloc(size_t size) {
+    if (_shard_count == 0u) {
+        return nullptr;
+    }
+
+    size_t home = get_home_shard();
+
+    for (size_t i = 0u; i < _shard_count; ++i) {
+        Shard& shard = _shards[(home + i) % _shard_count];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        void* result = koi_pool_alloc(&shard.pool, size);
+        if (result != nullptr) {
+            return result;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void* ShardedPool::calloc(size_t count, size_t size) {
+    if (size != 0u && count > SIZE_MAX / size) {
+        return nullptr;
+    }
+
+    void* result = alloc(count * size);
+    if (result != nullptr) {
+        memset(result, '\0', count * size);
+    }
+
+    return result;
+}
+
+
+void* ShardedPool::free(void* ptr) {
+    size_t index = get_shard(ptr);
+    if (index == _shard_count) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(_shards[index].mutex);
+    return koi_pool_free(&_shards[index].pool, ptr);
+}
+
+
+size_t ShardedPool::get_shard_count() const {
+    return _shard_count;
+}
+
+
+size_t ShardedPool::get_home_shard() const {
+#if defined(__linux__)
+    // the CPU can change right after, which only costs sharing a lock for a while
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return (size_t)cpu % _shard_count;
+    }
+#endif
+
+    // hashing thread ids can put many threads on 1 shard, so threads are numbered as they first allocate instead
+    static std::atomic<size_t> next_thread(0u);
+    static thread_local size_t thread_number = next_thread++;
+
+    return thread_number % _shard_count;
+}
+
+
+size_t ShardedPool::get_shard(const void* ptr) const {
+    const char* address = static_cast<const char*>(ptr);
+    if (ptr == nullptr || address < _memory || address >= _memory + _shard_count * _shard_bytes) {
+        return _shard_count;
+    }
+
+    return (size_t)(address - _memory) / _shard_bytes;
+}
+
+} // Koi
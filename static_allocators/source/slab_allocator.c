@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * A slab allocator that hands out same-sized objects from a contiguous array with an intrusive free list.
+ * Objects that have never been allocated are handed out in order, so initializing a slab doesn't touch its memory.
+ */
+
+
+#include "static_allocators/slab_allocator.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+
+/**
+ * A pointer after a char, so the pointer's offset is its alignment, without relying on C11's alignof. C++ doesn't allow
+ * defining the struct inside offsetof.
+ */
+typedef struct koi_pointer_alignment_t {
+    char c;
+    void* pointer;
+} PointerAlignment;
+
+#define KOI_POINTER_ALIGNMENT offsetof(PointerAlignment, pointer)
+
+
+int koi_slab_init(koi_slab_t* slab, void* buffer, size_t bytes, size_t size, size_t alignment) {
+    if (slab == NULL || buffer == NULL || size == 0u || alignment == 0u || (alignment & (alignment - 1u)) != 0u) {
+        return 0;
+    }
+
+    if (alignment < KOI_POINTER_ALIGNMENT) {
+        alignment = KOI_POINTER_ALIGNMENT;
+    }
+
+    // rounding sizes this big up to the alignment would wrap the stride around to 0
+    if (size > SIZE_MAX - alignment + 1u) {
+        return 0;
+    }
+
+    // skip the bytes at the front of the buffer that aren't aligned for an object
+    size_t padding = (alignment - ((uintptr_t)buffer & (alignment - 1u))) & (alignment - 1u);
+    size_t stride = KOI_SLAB_STRIDE(size, alignment);
+
+    if (bytes < padding || (bytes - padding) / stride == 0u) {
+        return 0;
+    }
+
+    slab->memory = (char*)buffer + padding;
+    slab->stride = stride;
+    slab->capacity = (bytes - padding) / stride;
+    slab->used = 0u;
+    slab->free_list = NULL;
+
+    return 1;
+}
+
+
+void* koi_slab_alloc(koi_slab_t* slab) {
+    void* result = NULL;
+
+    // reuse the most recently freed object, which is the most likely to still be in cache
+    if (slab->free_list != NULL) {
+        result = slab->free_list;
+        slab->free_list = *(void**)result;
+    } else if (slab->used < slab->capacity) {
+        result = slab->memory + slab->used * slab->stride;
+        ++slab->used;
+    }
+
+    return result;
+}
+
+
+void* koi_slab_calloc(koi_slab_t* slab) {
+    void* result = koi_slab_alloc(slab);
+
+    if (result != NULL) {
+        memset(result, '\0', slab->stride);
+    }
+
+    return result;
+}
+
+
+void* koi_slab_free(koi_slab_t* slab, void* ptr) {
+    char* object = (char*)ptr;
+
+    if (object == NULL || object < slab->memory || object >= slab->memory + slab->used * slab->stride) {
+        return NULL;
+    }
+
+    if ((size_t)(object - slab->memory) % slab->stride != 0u) {
+        return NULL;
+    }
+
+    *(void**)object = slab->free_list;
+    slab->free_list = object;
+
+    return NULL;
+}
@@ -0,0 +1,258 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/thread_cached_pool.hpp"
+
+#include <cstring>
+
+
+namespace Koi {
+
+constexpr size_t ThreadCachedPool::class_count;
+constexpr size_t ThreadCachedPool::magazine_size;
+constexpr size_t ThreadCachedPool::batch_size;
+
+
+/**
+ * A stack of freed allocations of 1 size class.
+ */
+struct ThreadCachedPool::Magazine {
+    void* items[magazine_size];
+    size_t count;
+};
+
+
+/**
+ * 1 thread's magazines for 1 pool. A thread's caches form a singly-linked list with the most recently used first.
+ */
+struct ThreadCachedPool::Cache {
+    uint64_t pool_id;
+    ThreadCachedPool* pool;
+    Magazine magazines[class_count];
+    Cache* next;
+};
+
+
+/**
+ * Owns the calling thread's caches and returns them to their pools when the thread exits. Pools are identified by
+ * id rather than address, so a cache whose pool was destroyed is never drained or matched to a new pool.
+ */
+struct ThreadCachedPool::ThreadCaches {
+    Cache* head = nullptr;
+
+    ~ThreadCaches() {
+        std::lock_guard<std::mutex> registry_lock(_registry_mutex);
+
+        while (head != nullptr) {
+            Cache* cache = head;
+            head = head->next;
+
+            if (_live_ids.find(cache->pool_id) != _live_ids.end()) {
+                for (Magazine& magazine : cache->magazines) {
+                    cache->pool->drain(magazine, magazine.count);
+                }
+            }
+
+            delete cache;
+        }
+    }
+};
+
+
+std::atomic<uint64_t> ThreadCachedPool::_next_id(1u);
+std::mutex ThreadCachedPool::_registry_mutex;
+std::unordered_set<uint64_t> ThreadCachedPool::_live_ids;
+thread_local ThreadCachedPool::ThreadCaches ThreadCachedPool::_thread_caches;
+
+
+ThreadCachedPool::ThreadCachedPool(): _pool(), _mutex(), _id(_next_id++) {
+    std::lock_guard<std::mutex> registry_lock(_registry_mutex);
+    _live_ids.insert(_id);
+}
+
+
+ThreadCachedPool::~ThreadCachedPool() {
+    std::lock_guard<std::mutex> registry_lock(_registry_mutex);
+    _live_ids.erase(_id);
+}
+
+
+bool ThreadCachedPool::init(void* buffer, size_t bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return koi_pool_init(&_pool, buffer, bytes) == 1;
+}
+
+
+void* ThreadCachedPool::alloc(size_t size) {
+    if (size == 0u) {
+        return nullptr;
+    }
+
+    // checked before rounding up to whole blocks, which could wrap around for huge sizes
+    if (size > class_count * KOI_BLOCK_SIZE) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return koi_pool_alloc(&_pool, size);
+    }
+
+    size_t blocks_needed = (size + KOI_BLOCK_SIZE - 1u) / KOI_BLOCK_SIZE;
+    Magazine& magazine = get_cache()->magazines[blocks_needed - 1u];
+    if (magazine.count == 0u) {
+        refill(magazine, blocks_needed * KOI_BLOCK_SIZE);
+    }
+
+    if (magazine.count == 0u) {
+        return nullptr;
+    }
+
+    return magazine.items[--magazine.count];
+}
+
+
+void* ThreadCachedPool::calloc(size_t count, size_t size) {
+    if (size != 0u && count > SIZE_MAX / size) {
+        return nullptr;
+    }
+
+    void* result = alloc(count * size);
+    if (result != nullptr) {
+        memset(result, '\0', count * size);
+    }
+
+    return result;
+}
+
+
+void* ThreadCachedPool::free(void* ptr) {
+    // reading the size only touches the allocation's own block, so no lock is needed
+    size_t size = koi_pool_get_size(&_pool, ptr);
+    if (size == 0u) {
+        return nullptr;
+    }
+
+    size_t blocks = size / KOI_BLOCK_SIZE;
+    if (blocks > class_count) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return koi_pool_free(&_pool, ptr);
+    }
+
+    Magazine& magazine = get_cache()->magazines[blocks - 1u];
+
+#ifndef NDEBUG
+    // the pool still sees a cached allocation as live, so a second free would put it in the magazine twice
+    for (size_t i = 0u; i < magazine.count; ++i) {
+        if (magazine.items[i] == ptr) {
+            return nullptr;
+        }
+    }
+#endif
+
+    if (magazine.count == magazine_size) {
+        drain(magazine, batch_size);
+    }
+
+    magazine.items[magazine.count++] = ptr;
+
+    return nullptr;
+}
+
+
+void ThreadCachedPool::flush() {
+    Cache* cache = get_cache();
+
+    for (Magazine& magazine : cache->magazines) {
+        drain(magazine, magazine.count);
+    }
+}
+
+
+ThreadCachedPool::Cache* ThreadCachedPool::get_cache() {
+    Cache* previous = nullptr;
+    Cache* cache = _thread_caches.head;
+
+    while (cache != nullptr && cache->pool_id != _id) {
+        previous = cache;
+        cache = cache->next;
+    }
+
+    // move the cache to the front so the pool a thread uses the most is found first
+    if (cache != nullptr) {
+        if (previous != nullptr) {
+            previous->next = cache->next;
+            cache->next = _thread_caches.head;
+            _thread_caches.head = cache;
+        }
+
+        return cache;
+    }
+
+    // this thread hasn't used this pool yet, so take the chance to delete caches of pools that were destroyed
+    {
+        std::lock_guard<std::mutex> registry_lock(_registry_mutex);
+        Cache** link = &_thread_caches.head;
+
+        while (*link != nullptr) {
+            if (_live_ids.find((*link)->pool_id) == _live_ids.end()) {
+                Cache* stale = *link;
+                *link = stale->next;
+                delete stale;
+            } else {
+                link = &(*link)->next;
+            }
+        }
+    }
+
+    cache = new Cache();
+    cache->pool_id = _id;
+    cache->pool = this;
+    cache->next = _thread_caches.head;
+    _thread_caches.head = cache;
+
+    return cache;
+}
+
+
+void ThreadCachedPool::refill(Magazine& magazine, size_t size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    while (magazine.count < batch_size) {
+        void* ptr = koi_pool_alloc(&_pool, size);
+        if (ptr == nullptr) {
+            break;
+        }
+
+        magazine.items[magazine.count++] = ptr;
+    }
+}
+
+
+void ThreadCachedPool::drain(Magazine& magazine, size_t count) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (size_t i = 0u; i < count; ++i) {
+        koi_pool_free(&_pool, magazine.items[--magazine.count]);
+    }
+}
+
+} // Koi
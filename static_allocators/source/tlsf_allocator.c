@@ -0,0 +1,397 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * A two-level segregated fit (TLSF) allocator. Free blocks are kept in lists by size: a first level per power of 2
+ * range, each divided linearly into KOI_TLSF_SL_COUNT second level lists. 1 bitmap per level records which lists have
+ * free blocks, so finding a free block big enough takes a couple of find-first-set instructions instead of a search.
+ * Every block knows its physical neighbours, so freeing merges in constant time too.
+ */
+
+
+#include "static_allocators/tlsf_allocator.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+/**
+ * The header of a block of memory, followed by its data. Only free blocks use next_free and previous_free, so they
+ * overlap the data of allocated blocks.
+ * previous_physical: the block right before this one in memory, or NULL if this is the first.
+ * size: the number of bytes of data, which is always a multiple of KOI_TLSF_ALIGNMENT, with KOI_TLSF_FREE_BIT set if
+ * the block is free.
+ */
+typedef struct koi_tlsf_block_t {
+    struct koi_tlsf_block_t* previous_physical;
+    size_t size;
+    struct koi_tlsf_block_t* next_free;
+    struct koi_tlsf_block_t* previous_free;
+} Block;
+
+#define KOI_TLSF_HEADER_SIZE offsetof(Block, next_free)
+#define KOI_TLSF_FREE_BIT ((size_t)1u)
+
+#define KOI_TLSF_ALIGNMENT (2u * sizeof(void*))
+#define KOI_TLSF_ALIGNMENT_LOG2 (sizeof(void*) == 8u ? 4u : 3u)
+
+/**
+ * The smallest block must hold the free list links.
+ */
+#define KOI_TLSF_MIN_BLOCK_SIZE (sizeof(Block) - KOI_TLSF_HEADER_SIZE)
+
+/**
+ * Sizes under KOI_TLSF_SMALL_SIZE all map to the first level list 0, divided linearly.
+ */
+#define KOI_TLSF_FL_SHIFT (KOI_TLSF_SL_COUNT_LOG2 + KOI_TLSF_ALIGNMENT_LOG2)
+#define KOI_TLSF_SMALL_SIZE ((size_t)1u << KOI_TLSF_FL_SHIFT)
+
+#define KOI_TLSF_MAX_BLOCK_SIZE (((size_t)1u << (KOI_TLSF_FL_SHIFT + KOI_TLSF_FL_COUNT - 1u)) - KOI_TLSF_ALIGNMENT)
+
+
+/**
+ * Gets the index of the lowest set bit of a non-zero word.
+ */
+static unsigned int find_first_set(unsigned int word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_ctz(word);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, word);
+    return (unsigned int)index;
+#else
+    unsigned int index = 0u;
+    while ((word & 1u) == 0u) {
+        word >>= 1u;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+
+/**
+ * Gets the index of the highest set bit of a non-zero word.
+ */
+static unsigned int find_last_set(size_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)(sizeof(unsigned long long) * 8u - 1u) - (unsigned int)__builtin_clzll((unsigned long long)word);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return (unsigned int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, (unsigned long)word);
+    return (unsigned int)index;
+#else
+    unsigned int index = 0u;
+    while ((word >>= 1u) != 0u) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+
+static size_t get_size(const Block* block) {
+    return block->size & ~KOI_TLSF_FREE_BIT;
+}
+
+
+static int is_free(const Block* block) {
+    return (block->size & KOI_TLSF_FREE_BIT) != 0u;
+}
+
+
+static char* get_data(Block* block) {
+    return (char*)block + KOI_TLSF_HEADER_SIZE;
+}
+
+
+static Block* get_next_physical(Block* block) {
+    return (Block*)(get_data(block) + get_size(block));
+}
+
+
+/**
+ * Gets the lists a block of the given size belongs in.
+ */
+static void get_list(size_t size, unsigned int* fl, unsigned int* sl) {
+    if (size < KOI_TLSF_SMALL_SIZE) {
+        *fl = 0u;
+        *sl = (unsigned int)(size / KOI_TLSF_ALIGNMENT);
+    } else {
+        unsigned int last_set = find_last_set(size);
+        *sl = (unsigned int)(size >> (last_set - KOI_TLSF_SL_COUNT_LOG2)) ^ KOI_TLSF_SL_COUNT;
+        *fl = last_set - (KOI_TLSF_FL_SHIFT - 1u);
+    }
+}
+
+
+/**
+ * Gets the first lists whose blocks are all at least the given size, by rounding it up to the next list's size.
+ */
+static void get_search_list(size_t size, unsigned int* fl, unsigned int* sl) {
+    if (size >= KOI_TLSF_SMALL_SIZE) {
+        size += ((size_t)1u << (find_last_set(size) - KOI_TLSF_SL_COUNT_LOG2)) - 1u;
+    }
+
+    get_list(size, fl, sl);
+}
+
+
+static void insert_free(koi_tlsf_t* tlsf, Block* block) {
+    unsigned int fl;
+    unsigned int sl;
+    get_list(get_size(block), &fl, &sl);
+
+    Block* head = tlsf->free_lists[fl][sl];
+    block->next_free = head;
+    block->previous_free = NULL;
+
+    if (head != NULL) {
+        head->previous_free = block;
+    }
+
+    tlsf->free_lists[fl][sl] = block;
+    tlsf->fl_bitmap |= 1u << fl;
+    tlsf->sl_bitmaps[fl] |= 1u << sl;
+}
+
+
+static void remove_free(koi_tlsf_t* tlsf, Block* block) {
+    unsigned int fl;
+    unsigned int sl;
+    get_list(get_size(block), &fl, &sl);
+
+    if (block->previous_free != NULL) {
+        block->previous_free->next_free = block->next_free;
+    } else {
+        tlsf->free_lists[fl][sl] = block->next_free;
+    }
+
+    if (block->next_free != NULL) {
+        block->next_free->previous_free = block->previous_free;
+    }
+
+    // if the list is empty now, clear its bits
+    if (tlsf->free_lists[fl][sl] == NULL) {
+        tlsf->sl_bitmaps[fl] &= ~(1u << sl);
+
+        if (tlsf->sl_bitmaps[fl] == 0u) {
+            tlsf->fl_bitmap &= ~(1u << fl);
+        }
+    }
+}
+
+
+/**
+ * Gets a free block of at least the given size, without removing it from its list.
+ * @return The block, or NULL if none is big enough.
+ */
+static Block* find_free(koi_tlsf_t* tlsf, size_t size) {
+    unsigned int fl;
+    unsigned int sl;
+    get_search_list(size, &fl, &sl);
+
+    if (fl >= KOI_TLSF_FL_COUNT) {
+        return NULL;
+    }
+
+    // any list in this first level at or after the second level
+    unsigned int sl_bitmap = tlsf->sl_bitmaps[fl] & (~0u << sl);
+
+    if (sl_bitmap == 0u) {
+        // otherwise the smallest list of any bigger first level
+        unsigned int fl_bitmap = fl + 1u < KOI_TLSF_FL_COUNT ? tlsf->fl_bitmap & (~0u << (fl + 1u)) : 0u;
+        if (fl_bitmap == 0u) {
+            return NULL;
+        }
+
+        fl = find_first_set(fl_bitmap);
+        sl_bitmap = tlsf->sl_bitmaps[fl];
+    }
+
+    return tlsf->free_lists[fl][find_first_set(sl_bitmap)];
+}
+
+
+size_t koi_tlsf_get_header_size(void) {
+    return KOI_TLSF_HEADER_SIZE;
+}
+
+
+int koi_tlsf_init(koi_tlsf_t* tlsf, void* buffer, size_t bytes) {
+    if (tlsf == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    // skip the bytes at the front of the buffer that aren't aligned for a block
+    size_t padding = (KOI_TLSF_ALIGNMENT - ((uintptr_t)buffer % KOI_TLSF_ALIGNMENT)) % KOI_TLSF_ALIGNMENT;
+    if (bytes < padding) {
+        return 0;
+    }
+
+    // the memory holds 1 free block and an empty, allocated block at the end so every block has a next block
+    size_t usable = (bytes - padding) / KOI_TLSF_ALIGNMENT * KOI_TLSF_ALIGNMENT;
+    if (usable < 2u * KOI_TLSF_HEADER_SIZE + KOI_TLSF_MIN_BLOCK_SIZE) {
+        return 0;
+    }
+
+    size_t size = usable - 2u * KOI_TLSF_HEADER_SIZE;
+    if (size > KOI_TLSF_MAX_BLOCK_SIZE) {
+        size = KOI_TLSF_MAX_BLOCK_SIZE;
+    }
+
+    memset(tlsf, 0, sizeof(koi_tlsf_t));
+    tlsf->memory = (char*)buffer + padding;
+    tlsf->bytes = size + 2u * KOI_TLSF_HEADER_SIZE;
+
+    Block* block = (Block*)tlsf->memory;
+    block->previous_physical = NULL;
+    block->size = size | KOI_TLSF_FREE_BIT;
+
+    Block* sentinel = get_next_physical(block);
+    sentinel->previous_physical = block;
+    sentinel->size = 0u;
+
+    insert_free(tlsf, block);
+
+    return 1;
+}
+
+
+void* koi_tlsf_alloc(koi_tlsf_t* tlsf, size_t size) {
+    if (size == 0u || size > KOI_TLSF_MAX_BLOCK_SIZE) {
+        return NULL;
+    }
+
+    size_t block_size = (size + KOI_TLSF_ALIGNMENT - 1u) / KOI_TLSF_ALIGNMENT * KOI_TLSF_ALIGNMENT;
+    if (block_size < KOI_TLSF_MIN_BLOCK_SIZE) {
+        block_size = KOI_TLSF_MIN_BLOCK_SIZE;
+    }
+
+    Block* block = find_free(tlsf, block_size);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    remove_free(tlsf, block);
+
+    // if enough is left over for another block, split it off and free it
+    size_t remaining = get_size(block) - block_size;
+    if (remaining >= KOI_TLSF_HEADER_SIZE + KOI_TLSF_MIN_BLOCK_SIZE) {
+        Block* next = get_next_physical(block);
+        Block* split = (Block*)(get_data(block) + block_size);
+
+        split->previous_physical = block;
+        split->size = (remaining - KOI_TLSF_HEADER_SIZE) | KOI_TLSF_FREE_BIT;
+        next->previous_physical = split;
+        insert_free(tlsf, split);
+
+        block->size = block_size;
+    } else {
+        block->size = get_size(block);
+    }
+
+    return get_data(block);
+}
+
+
+void* koi_tlsf_calloc(koi_tlsf_t* tlsf, size_t count, size_t size) {
+    if (size != 0u && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void* result = koi_tlsf_alloc(tlsf, count * size);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    memset(result, '\0', count * size);
+
+    return result;
+}
+
+
+void* koi_tlsf_free(koi_tlsf_t* tlsf, void* ptr) {
+    char* data = (char*)ptr;
+
+    if (data == NULL || data < tlsf->memory + KOI_TLSF_HEADER_SIZE || data >= tlsf->memory + tlsf->bytes) {
+        return NULL;
+    }
+
+    if ((size_t)(data - tlsf->memory) % KOI_TLSF_ALIGNMENT != 0u) {
+        return NULL;
+    }
+
+    // a real block is either the first one or right after its previous block, and isn't free yet
+    Block* block = (Block*)(data - KOI_TLSF_HEADER_SIZE);
+    if (is_free(block) || block->size == 0u) {
+        return NULL;
+    }
+
+    Block* previous = block->previous_physical;
+    if (previous == NULL) {
+        if ((char*)block != tlsf->memory) {
+            return NULL;
+        }
+    } else if ((char*)previous < tlsf->memory || previous >= block || get_next_physical(previous) != block) {
+        return NULL;
+    }
+
+    // merge with the previous block if it is free
+    if (previous != NULL && is_free(previous)) {
+        remove_free(tlsf, previous);
+        previous->size = get_size(previous) + KOI_TLSF_HEADER_SIZE + get_size(block);
+        block = previous;
+    }
+
+    // merge with the next block if it is free
+    Block* next = get_next_physical(block);
+    if (is_free(next)) {
+        remove_free(tlsf, next);
+        block->size = get_size(block) + KOI_TLSF_HEADER_SIZE + get_size(next);
+        next = get_next_physical(block);
+    }
+
+    next->previous_physical = block;
+    block->size |= KOI_TLSF_FREE_BIT;
+    insert_free(tlsf, block);
+
+    return NULL;
+}
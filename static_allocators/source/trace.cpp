@@ -0,0 +1,169 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/trace.hpp"
+
+#include <cstring>
+
+
+namespace Koi {
+
+constexpr size_t TraceWriter::record_size;
+constexpr size_t TraceWriter::buffer_records;
+
+
+/**
+ * The bytes every trace file starts with.
+ */
+static const char trace_magic[8u] = {'K', 'O', 'I', 'T', 'R', 'A', 'C', 'E'};
+
+
+/**
+ * Writes the lowest bytes of the value into out, least significant first.
+ */
+static void encode(uint64_t value, size_t bytes, unsigned char* out) {
+    for (size_t i = 0u; i < bytes; ++i) {
+        out[i] = (unsigned char)(value >> (8u * i));
+    }
+}
+
+
+/**
+ * Reads a value of the given number of bytes from in, least significant first.
+ */
+static uint64_t decode(const unsigned char* in, size_t bytes) {
+    uint64_t value = 0u;
+
+    for (size_t i = 0u; i < bytes; ++i) {
+        value |= (uint64_t)in[i] << (8u * i);
+    }
+
+    return value;
+}
+
+
+TraceWriter::TraceWriter(): _file(nullptr), _start(), _buffer() {
+}
+
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+
+bool TraceWriter::open(const char* path) {
+    close();
+
+    _file = fopen(path, "wb");
+    if (_file == nullptr) {
+        return false;
+    }
+
+    if (fwrite(trace_magic, 1u, sizeof(trace_magic), _file) != sizeof(trace_magic)) {
+        fclose(_file);
+        _file = nullptr;
+        return false;
+    }
+
+    _buffer.reserve(buffer_records * record_size);
+    _start = std::chrono::steady_clock::now();
+
+    return true;
+}
+
+
+void TraceWriter::record(size_t id, size_t size) {
+    if (_file == nullptr) {
+        return;
+    }
+
+    uint64_t timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - _start
+    ).count();
+
+    unsigned char record[record_size];
+    encode(timestamp, 8u, record);
+    encode(id > UINT32_MAX ? UINT32_MAX : id, 4u, record + 8u);
+    encode(size > UINT32_MAX ? UINT32_MAX : size, 4u, record + 12u);
+
+    _buffer.insert(_buffer.end(), record, record + record_size);
+
+    if (_buffer.size() >= buffer_records * record_size) {
+        flush();
+    }
+}
+
+
+void TraceWriter::close() {
+    if (_file == nullptr) {
+        return;
+    }
+
+    flush();
+    fclose(_file);
+    _file = nullptr;
+}
+
+
+void TraceWriter::callback(void* user_data, size_t id, size_t size) {
+    static_cast<TraceWriter*>(user_data)->record(id, size);
+}
+
+
+void TraceWriter::flush() {
+    if (!_buffer.empty()) {
+        fwrite(_buffer.data(), 1u, _buffer.size(), _file);
+        _buffer.clear();
+    }
+}
+
+
+bool read_trace(const char* path, std::vector<TraceRecord>& records) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    char magic[sizeof(trace_magic)];
+    if (fread(magic, 1u, sizeof(magic), file) != sizeof(magic) || memcmp(magic, trace_magic, sizeof(magic)) != 0) {
+        fclose(file);
+        return false;
+    }
+
+    unsigned char record[TraceWriter::record_size];
+    while (fread(record, 1u, sizeof(record), file) == sizeof(record)) {
+        TraceRecord result;
+        result.timestamp = decode(record, 8u);
+        result.id = (uint32_t)decode(record + 8u, 4u);
+        result.size = (uint32_t)decode(record + 12u, 4u);
+        records.push_back(result);
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+} // Koi
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/arena_allocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+
+TEST_CASE("Arena Allocations", "[Arena]") {
+    alignas(64) char buffer[256u];
+    koi_arena_t arena;
+    REQUIRE(koi_arena_init(&arena, buffer, sizeof(buffer)) == 1);
+
+    char* first = (char*)koi_arena_alloc(&arena, 3u);
+    char* second = (char*)koi_arena_alloc(&arena, 8u);
+
+    REQUIRE(first != nullptr);
+    REQUIRE(second != nullptr);
+    CHECK((first == buffer));
+    CHECK((second == buffer + KOI_ARENA_DEFAULT_ALIGNMENT));
+
+    char* aligned = (char*)koi_arena_alloc_aligned(&arena, 1u, 64u);
+    CHECK((aligned == buffer + 64u));
+    CHECK((koi_arena_alloc_aligned(&arena, 1u, 48u) == nullptr));
+
+    // too big for what's left
+    CHECK((koi_arena_alloc(&arena, 256u) == nullptr));
+    CHECK((koi_arena_alloc(&arena, SIZE_MAX) == nullptr));
+
+    koi_arena_reset(&arena);
+    CHECK((koi_arena_alloc(&arena, 256u) == buffer));
+
+    // calloc zeroes what earlier allocations left behind
+    koi_arena_reset(&arena);
+    buffer[0u] = 'A';
+    CHECK((koi_arena_calloc(&arena, SIZE_MAX / 2u, 4u) == nullptr));
+    char* zeroed = (char*)koi_arena_calloc(&arena, 4u, 64u);
+    CHECK((zeroed == buffer));
+    CHECK(zeroed[0u] == '\0');
+}
+
+
+TEST_CASE("Arena Markers", "[Arena]") {
+    char buffer[128u];
+    koi_arena_t arena;
+    REQUIRE(koi_arena_init(&arena, buffer, sizeof(buffer)) == 1);
+
+    char* kept = (char*)koi_arena_alloc_aligned(&arena, 16u, 1u);
+    REQUIRE(kept != nullptr);
+    kept[0u] = 'A';
+
+    koi_arena_marker_t marker = koi_arena_mark(&arena);
+    char* temporary = (char*)koi_arena_alloc_aligned(&arena, 100u, 1u);
+    REQUIRE(temporary != nullptr);
+    temporary[0u] = 'B';
+
+    CHECK((koi_arena_alloc_aligned(&arena, 100u, 1u) == nullptr));
+
+    // rewinding frees everything after the marker, so its memory is allocated again
+    koi_arena_rewind_to_mark(&arena, marker);
+    char* reused = (char*)koi_arena_alloc_aligned(&arena, 100u, 1u);
+    CHECK((reused == temporary));
+    CHECK(kept[0u] == 'A');
+
+    // a marker ahead of the arena's allocations is ignored
+    koi_arena_rewind_to_mark(&arena, marker);
+    koi_arena_rewind_to_mark(&arena, marker + 100u);
+    CHECK(koi_arena_mark(&arena) == marker);
+}
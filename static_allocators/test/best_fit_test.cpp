@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/allocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <vector>
+
+
+#if KOI_FIT_POLICY != KOI_FIT_BEST || KOI_SIZE_CLASS_MAX_SIZE > 0u
+#error "best_fit_test.cpp tests a memory pool built with KOI_FIT_POLICY KOI_FIT_BEST and no size classes."
+#endif
+
+
+/**
+ * Makes the given number of equal free sections, each between 2 live allocations, then times allocating and freeing
+ * the section that fits best, which is the one the free section tree puts first.
+ * @return The nanoseconds per allocation and free, the fastest of a few runs.
+ */
+static double time_holes(size_t hole_count) {
+    const size_t hole_size = 6u * KOI_BLOCK_SIZE;
+    std::vector<char> buffer((hole_count + 1u) * 9u * KOI_BLOCK_SIZE);
+    koi_pool_t pool;
+    REQUIRE(koi_pool_init(&pool, buffer.data(), buffer.size()) == 1);
+
+    std::vector<void*> holes(hole_count);
+    for (void*& hole : holes) {
+        hole = koi_pool_alloc(&pool, hole_size);
+        REQUIRE(koi_pool_alloc(&pool, 1u) != nullptr);
+    }
+
+    for (void* hole : holes) {
+        koi_pool_free(&pool, hole);
+    }
+
+    double best = 0.0;
+    for (size_t run = 0u; run < 5u; ++run) {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for (size_t i = 0u; i < 200u; ++i) {
+            void* ptr = koi_pool_alloc(&pool, hole_size);
+            REQUIRE((ptr == holes[0u]));
+            koi_pool_free(&pool, ptr);
+        }
+        double elapsed = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count() / 200.0;
+
+        best = run == 0u || elapsed < best ? elapsed : best;
+    }
+
+    return best;
+}
+
+
+TEST_CASE("Best Fit Scales With Free Sections", "[BestFit]") {
+    // the tree is O(log n) deep in expectation, so 16 times the free sections costs a few more levels, where a tree
+    // degenerated into a list would cost 16 times as much
+    double few = time_holes(4096u);
+    double many = time_holes(65536u);
+
+    CHECK(many < 8.0 * few + 1000.0);
+}
@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/bitmap_allocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+TEST_CASE("Bitmap Allocations", "[Bitmap]") {
+    koi_bitmap_t bitmap;
+    char buffer[4096u + 1u];
+
+    CHECK(koi_bitmap_init(&bitmap, buffer, 8u) == 0);
+    REQUIRE(koi_bitmap_init(&bitmap, buffer + 1u, sizeof(buffer) - 1u) == 1);
+
+    CHECK((koi_bitmap_alloc(&bitmap, 0u) == nullptr));
+    CHECK((koi_bitmap_alloc(&bitmap, bitmap.unit_count * KOI_BITMAP_UNIT_SIZE + 1u) == nullptr));
+
+    char* first = (char*)koi_bitmap_alloc(&bitmap, 1u);
+    char* second = (char*)koi_bitmap_alloc(&bitmap, KOI_BITMAP_UNIT_SIZE + 1u);
+    char* third = (char*)koi_bitmap_alloc(&bitmap, KOI_BITMAP_UNIT_SIZE);
+    REQUIRE(first != nullptr);
+    REQUIRE(second != nullptr);
+    REQUIRE(third != nullptr);
+    CHECK(((uintptr_t)first % KOI_BITMAP_UNIT_SIZE) == 0u);
+
+    // allocations are packed back to back, with no headers between them
+    CHECK((second == first + KOI_BITMAP_UNIT_SIZE));
+    CHECK((third == second + 2u * KOI_BITMAP_UNIT_SIZE));
+    CHECK(koi_bitmap_get_size(&bitmap, second) == 2u * KOI_BITMAP_UNIT_SIZE);
+
+    // pointers inside an allocation aren't freed
+    CHECK(koi_bitmap_get_size(&bitmap, second + KOI_BITMAP_UNIT_SIZE) == 0u);
+    koi_bitmap_free(&bitmap, second + KOI_BITMAP_UNIT_SIZE);
+    CHECK(koi_bitmap_get_size(&bitmap, second) == 2u * KOI_BITMAP_UNIT_SIZE);
+
+    // the freed run is reused by an allocation that fits, and skipped by 1 that doesn't
+    koi_bitmap_free(&bitmap, second);
+    CHECK(koi_bitmap_get_size(&bitmap, second) == 0u);
+
+    char* bigger = (char*)koi_bitmap_alloc(&bitmap, 3u * KOI_BITMAP_UNIT_SIZE);
+    CHECK((bigger == third + KOI_BITMAP_UNIT_SIZE));
+
+    char* reused = (char*)koi_bitmap_alloc(&bitmap, 2u * KOI_BITMAP_UNIT_SIZE);
+    CHECK((reused == second));
+
+    koi_bitmap_free(&bitmap, first);
+    koi_bitmap_free(&bitmap, reused);
+    koi_bitmap_free(&bitmap, third);
+    koi_bitmap_free(&bitmap, bigger);
+
+    // once everything is freed, the whole bitmap allocator can be allocated at once
+    char* all = (char*)koi_bitmap_alloc(&bitmap, bitmap.unit_count * KOI_BITMAP_UNIT_SIZE);
+    CHECK((all == first));
+    koi_bitmap_free(&bitmap, all);
+}
+
+
+TEST_CASE("Bitmap Stress", "[Bitmap]") {
+    const size_t live_count = 256u;
+    static char buffer[1u << 16u];
+    koi_bitmap_t bitmap;
+    REQUIRE(koi_bitmap_init(&bitmap, buffer, sizeof(buffer)) == 1);
+
+    std::mt19937 random(7u);
+    std::uniform_int_distribution<size_t> pick_size(1u, 300u);
+    std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+
+    std::vector<unsigned char*> live(live_count, nullptr);
+    std::vector<size_t> sizes(live_count, 0u);
+    size_t failures = 0u;
+
+    // runs cross word boundaries in the bitmaps, and each allocation is filled with its slot so overlaps are caught
+    for (size_t i = 0u; i < 20000u; ++i) {
+        size_t slot = pick_slot(random);
+
+        if (live[slot] != nullptr) {
+            for (size_t j = 0u; j < sizes[slot]; ++j) {
+                if (live[slot][j] != (unsigned char)slot) {
+                    ++failures;
+                    break;
+                }
+            }
+
+            koi_bitmap_free(&bitmap, live[slot]);
+        }
+
+        sizes[slot] = pick_size(random);
+        live[slot] = (unsigned char*)koi_bitmap_alloc(&bitmap, sizes[slot]);
+        REQUIRE(live[slot] != nullptr);
+        memset(live[slot], (int)slot, sizes[slot]);
+    }
+
+    CHECK(failures == 0u);
+
+    for (unsigned char* ptr : live) {
+        koi_bitmap_free(&bitmap, ptr);
+    }
+
+    CHECK((koi_bitmap_alloc(&bitmap, bitmap.unit_count * KOI_BITMAP_UNIT_SIZE) != nullptr));
+}
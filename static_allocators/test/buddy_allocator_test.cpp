@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/buddy_allocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+/**
+ * Gets the biggest power of 2 allocation the buddy allocator can make right now, without keeping it.
+ */
+static size_t get_biggest_allocation(koi_buddy_t* buddy) {
+    size_t result = 0u;
+
+    for (size_t size = KOI_BUDDY_MIN_BLOCK_SIZE; size <= buddy->bytes; size <<= 1u) {
+        void* ptr = koi_buddy_alloc(buddy, size);
+
+        if (ptr != nullptr) {
+            result = size;
+            koi_buddy_free(buddy, ptr);
+        }
+    }
+
+    return result;
+}
+
+
+TEST_CASE("Buddy Allocations", "[Buddy]") {
+    koi_buddy_t buddy;
+    char tiny[KOI_BUDDY_MIN_BLOCK_SIZE];
+    CHECK(koi_buddy_init(&buddy, tiny, sizeof(tiny)) == 0);
+
+    // not a power of 2, so some blocks are left over at the end
+    static char buffer[100u * KOI_BUDDY_MIN_BLOCK_SIZE + 3u];
+    REQUIRE(koi_buddy_init(&buddy, buffer + 3u, sizeof(buffer) - 3u) == 1);
+
+    // every smallest block can be allocated, and none past the end of the memory
+    std::vector<char*> blocks;
+    char* block = (char*)koi_buddy_alloc(&buddy, 1u);
+    while (block != nullptr) {
+        CHECK((block >= buddy.memory));
+        CHECK((block + KOI_BUDDY_MIN_BLOCK_SIZE <= buddy.memory + buddy.bytes));
+        blocks.push_back(block);
+        block = (char*)koi_buddy_alloc(&buddy, 1u);
+    }
+
+    CHECK(blocks.size() * KOI_BUDDY_MIN_BLOCK_SIZE == buddy.bytes);
+
+    for (char* ptr : blocks) {
+        koi_buddy_free(&buddy, ptr);
+    }
+
+    // every block merged back, so the biggest block is available again
+    size_t biggest = get_biggest_allocation(&buddy);
+    CHECK(biggest >= buddy.bytes / 2u);
+
+    char* ptr = (char*)koi_buddy_alloc(&buddy, biggest);
+    REQUIRE(ptr != nullptr);
+    CHECK((koi_buddy_alloc(&buddy, biggest) == nullptr));
+
+    // pointers inside an allocation, or already freed, are ignored
+    koi_buddy_free(&buddy, ptr + KOI_BUDDY_MIN_BLOCK_SIZE);
+    CHECK((koi_buddy_alloc(&buddy, biggest) == nullptr));
+
+    ptr[0u] = 'A';
+    koi_buddy_free(&buddy, ptr);
+    koi_buddy_free(&buddy, ptr);
+    CHECK(get_biggest_allocation(&buddy) == biggest);
+
+    // calloc zeroes the block it reuses
+    CHECK((koi_buddy_calloc(&buddy, SIZE_MAX / 2u, 4u) == nullptr));
+    char* zeroed = (char*)koi_buddy_calloc(&buddy, biggest / 4u, 4u);
+    CHECK((zeroed == ptr));
+    CHECK(zeroed[0u] == '\0');
+}
+
+
+TEST_CASE("Buddy Random Allocations", "[Buddy]") {
+    static char buffer[4096u * KOI_BUDDY_MIN_BLOCK_SIZE];
+    koi_buddy_t buddy;
+    REQUIRE(koi_buddy_init(&buddy, buffer, sizeof(buffer)) == 1);
+
+    size_t biggest = get_biggest_allocation(&buddy);
+
+    std::mt19937 random(3u);
+    std::uniform_int_distribution<size_t> pick_size(1u, 2000u);
+    std::vector<unsigned char*> live(64u, nullptr);
+    std::vector<size_t> sizes(64u, 0u);
+    size_t corrupted = 0u;
+
+    for (size_t i = 0u; i < 20000u; ++i) {
+        size_t slot = i % live.size();
+
+        if (live[slot] != nullptr) {
+            for (size_t j = 0u; j < sizes[slot]; ++j) {
+                corrupted += live[slot][j] != (unsigned char)slot;
+            }
+
+            koi_buddy_free(&buddy, live[slot]);
+        }
+
+        sizes[slot] = pick_size(random);
+        live[slot] = (unsigned char*)koi_buddy_alloc(&buddy, sizes[slot]);
+        REQUIRE(live[slot] != nullptr);
+        memset(live[slot], (int)slot, sizes[slot]);
+    }
+
+    CHECK(corrupted == 0u);
+
+    for (unsigned char* ptr : live) {
+        koi_buddy_free(&buddy, ptr);
+    }
+
+    CHECK(get_biggest_allocation(&buddy) == biggest);
+}
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/allocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+
+#if KOI_SIZE_CLASS_MAX_SIZE < 4096u || KOI_SIZE_CLASS_FLUSH_THRESHOLD != 1024u
+#error "flush_threshold_test.cpp tests a memory pool built with KOI_SIZE_CLASS_FLUSH_THRESHOLD 1024u."
+#endif
+
+
+TEST_CASE("Flush Threshold", "[FlushThreshold]") {
+    const size_t size = 3u * KOI_BLOCK_SIZE;
+    koi_pool_t pool;
+    char buffer[64u * KOI_BLOCK_SIZE];
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+    CHECK(pool.size_class_blocks == 0u);
+
+    void* ptrs[10u];
+    for (void*& ptr : ptrs) {
+        ptr = koi_pool_alloc(&pool, size);
+        REQUIRE(ptr != nullptr);
+    }
+
+    // freed allocations are parked and counted
+    koi_pool_stats_t stats;
+    for (size_t i = 0u; i < 3u; ++i) {
+        koi_pool_free(&pool, ptrs[i]);
+    }
+
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(pool.size_class_blocks == 9u);
+    CHECK(stats.size_class_bytes == 3u * size);
+
+    // reusing 1 from its size class takes it off the count
+    void* reused = koi_pool_alloc(&pool, size);
+    CHECK((reused == ptrs[2u]));
+
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(pool.size_class_blocks == 6u);
+    CHECK(stats.size_class_bytes == 2u * size);
+    koi_pool_free(&pool, reused);
+
+    // the size classes hold up to 1024 bytes, 7 of these, and the free that would make it 8 merges only its own
+    for (size_t i = 3u; i < 7u; ++i) {
+        koi_pool_free(&pool, ptrs[i]);
+
+        koi_pool_get_stats(&pool, &stats);
+        CHECK(pool.size_class_blocks == (i + 1u) * 3u);
+        CHECK(stats.size_class_bytes == (i + 1u) * size);
+    }
+
+    koi_pool_free(&pool, ptrs[7u]);
+
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(pool.size_class_blocks == 21u);
+    CHECK(stats.size_class_bytes == 7u * size);
+    CHECK(stats.bytes_in_use == 2u * size);
+
+    // it stays its own section, between the parked allocation before it and the 2 still allocated after it
+    CHECK(stats.free_segments == 2u);
+    CHECK(koi_pool_get_size(&pool, ptrs[7u]) == 0u);
+
+    // reusing a parked allocation makes room to park again
+    reused = koi_pool_alloc(&pool, size);
+    CHECK((reused == ptrs[6u]));
+    CHECK(pool.size_class_blocks == 18u);
+
+    koi_pool_free(&pool, reused);
+    CHECK(pool.size_class_blocks == 21u);
+
+    // a flush because an allocation missed merges everything and starts the count over
+    void* ptr = koi_pool_alloc(&pool, 60u * KOI_BLOCK_SIZE);
+    CHECK((ptr == nullptr));
+    CHECK(pool.size_class_blocks == 0u);
+
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(stats.size_class_bytes == 0u);
+    CHECK(stats.largest_free_segment >= 8u * size + 7u * KOI_BLOCK_SIZE);
+
+    koi_pool_free(&pool, ptrs[8u]);
+    CHECK(pool.size_class_blocks == 3u);
+
+    koi_pool_free(&pool, ptrs[9u]);
+    koi_pool_free(&pool, koi_pool_alloc(&pool, (pool.block_count - 1u) * KOI_BLOCK_SIZE));
+    CHECK(pool.size_class_blocks == 0u);
+}
@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/frame_allocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+
+TEST_CASE("Frame Allocations", "[Frame]") {
+    alignas(16) char buffer[3u * 256u];
+    koi_frame_allocator_t frames;
+
+    CHECK(koi_frame_init(&frames, buffer, sizeof(buffer), 0u) == 0);
+    CHECK(koi_frame_init(&frames, buffer, sizeof(buffer), KOI_FRAME_BUFFER_COUNT_MAX + 1u) == 0);
+    CHECK(koi_frame_init(&frames, buffer, 8u, 2u) == 0);
+    REQUIRE(koi_frame_init(&frames, buffer, sizeof(buffer), 3u) == 1);
+
+    // each frame bump allocates from its own buffer
+    char* data[6u];
+    for (size_t k = 0u; k < 6u; ++k) {
+        if (k > 0u) {
+            CHECK(koi_frame_begin(&frames) == k);
+        }
+
+        CHECK(koi_frame_get_used(&frames) == 0u);
+
+        data[k] = (char*)koi_frame_alloc(&frames, 100u);
+        REQUIRE(data[k] != nullptr);
+        CHECK((data[k] == buffer + (k % 3u) * 256u));
+
+        // the frames before, up to the number of buffers, are untouched by this one
+        memset(data[k], (int)('A' + k), 100u);
+        for (size_t j = k >= 2u ? k - 2u : 0u; j < k; ++j) {
+            CHECK(data[j][0u] == (char)('A' + j));
+        }
+    }
+
+    CHECK((koi_frame_alloc(&frames, 200u) == nullptr));
+    char* aligned = (char*)koi_frame_alloc_aligned(&frames, 1u, 64u);
+    REQUIRE(aligned != nullptr);
+    CHECK(((uintptr_t)aligned % 64u) == 0u);
+
+    // the buffer comes back for the frame that reuses it, zeroed when asked for
+    koi_frame_begin(&frames);
+    char* reused = (char*)koi_frame_calloc(&frames, 100u, 1u);
+    CHECK((reused == data[3u]));
+    CHECK(reused[0u] == '\0');
+}
@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/handle_allocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+
+TEST_CASE("Handle Allocations", "[Handle]") {
+    koi_handle_pool_t pool;
+    char buffer[4096u + 1u];
+
+    CHECK(koi_handle_pool_init(&pool, buffer, sizeof(buffer), 0u) == 0);
+    CHECK(koi_handle_pool_init(&pool, buffer, 64u, 16u) == 0);
+    REQUIRE(koi_handle_pool_init(&pool, buffer + 1u, sizeof(buffer) - 1u, 2u) == 1);
+
+    CHECK(koi_handle_alloc(&pool, 0u) == KOI_HANDLE_NULL);
+    CHECK((koi_handle_get(&pool, KOI_HANDLE_NULL) == nullptr));
+
+    koi_handle_t first = koi_handle_alloc(&pool, 100u);
+    koi_handle_t second = koi_handle_alloc(&pool, 100u);
+    REQUIRE(first != KOI_HANDLE_NULL);
+    REQUIRE(second != KOI_HANDLE_NULL);
+
+    char* data = (char*)koi_handle_get(&pool, first);
+    REQUIRE(data != nullptr);
+    CHECK(((uintptr_t)data % KOI_HANDLE_ALIGNMENT) == 0u);
+
+    // the handle table is full
+    CHECK(koi_handle_alloc(&pool, 100u) == KOI_HANDLE_NULL);
+
+    // a freed handle never resolves again, even once its entry is reused
+    koi_handle_free(&pool, first);
+    CHECK((koi_handle_get(&pool, first) == nullptr));
+
+    koi_handle_t third = koi_handle_alloc(&pool, 100u);
+    REQUIRE(third != KOI_HANDLE_NULL);
+    CHECK(third != first);
+    CHECK((koi_handle_get(&pool, first) == nullptr));
+    CHECK((koi_handle_get(&pool, third) != nullptr));
+
+    // freeing twice does nothing
+    koi_handle_free(&pool, first);
+    CHECK((koi_handle_get(&pool, third) != nullptr));
+
+    koi_handle_free(&pool, second);
+    koi_handle_free(&pool, third);
+
+    // with no budget, each call still handles 1 allocation or hole
+    CHECK(koi_handle_compact(&pool, 0u) == 0);
+    CHECK(koi_handle_compact(&pool, 0u) == 1);
+    CHECK(koi_handle_get_available(&pool) == pool.heap_bytes);
+}
+
+
+TEST_CASE("Handle Compaction", "[Handle]") {
+    static char buffer[64u * 1024u];
+    koi_handle_pool_t pool;
+    REQUIRE(koi_handle_pool_init(&pool, buffer, sizeof(buffer), 256u) == 1);
+
+    const size_t count = 128u;
+    const size_t size = 200u;
+    koi_handle_t handles[count];
+
+    for (size_t i = 0u; i < count; ++i) {
+        handles[i] = koi_handle_alloc(&pool, size);
+        REQUIRE(handles[i] != KOI_HANDLE_NULL);
+        memset(koi_handle_get(&pool, handles[i]), (int)i, size);
+    }
+
+    // free every other allocation, leaving holes that a big allocation can't use
+    for (size_t i = 0u; i < count; i += 2u) {
+        koi_handle_free(&pool, handles[i]);
+        handles[i] = KOI_HANDLE_NULL;
+    }
+
+    size_t big = koi_handle_get_available(&pool) + 64u * size;
+    CHECK(koi_handle_alloc(&pool, big) == KOI_HANDLE_NULL);
+
+    // compact a little at a time, allocating and freeing between calls
+    size_t calls = 0u;
+    while (koi_handle_compact(&pool, 1024u) == 0) {
+        ++calls;
+
+        if (calls == 5u) {
+            koi_handle_free(&pool, handles[1u]);
+            handles[1u] = KOI_HANDLE_NULL;
+
+            handles[0u] = koi_handle_alloc(&pool, size);
+            REQUIRE(handles[0u] != KOI_HANDLE_NULL);
+            memset(koi_handle_get(&pool, handles[0u]), 0, size);
+        }
+
+        REQUIRE(calls < 1000u);
+    }
+
+    CHECK(calls > 1u);
+
+    // every live allocation kept its bytes through its handle
+    for (size_t i = 2u; i < count; ++i) {
+        if (handles[i] == KOI_HANDLE_NULL) {
+            continue;
+        }
+
+        unsigned char* data = (unsigned char*)koi_handle_get(&pool, handles[i]);
+        REQUIRE(data != nullptr);
+        CHECK(data[0u] == (unsigned char)i);
+        CHECK(data[size - 1u] == (unsigned char)i);
+    }
+
+    CHECK(koi_handle_alloc(&pool, big - 2u * size) != KOI_HANDLE_NULL);
+}
@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/lock_free_block_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("Lock Free Block Pool", "[LockFreeBlockPool]") {
+    static Koi::LockFreeBlockPool<24u, 8u, 16u> pool;
+    CHECK(pool.block_size == 32u);
+
+    // every block can be allocated once, aligned, and then the pool is empty
+    std::set<void*> ptrs;
+    for (size_t i = 0u; i < 8u; ++i) {
+        void* ptr = pool.alloc();
+        REQUIRE(ptr != nullptr);
+        CHECK((uintptr_t)ptr % 16u == 0u);
+        memset(ptr, 'A', 24u);
+        ptrs.insert(ptr);
+    }
+
+    CHECK(ptrs.size() == 8u);
+    CHECK((pool.alloc() == nullptr));
+
+    // pointers that aren't blocks of the pool are ignored
+    int not_in_pool = 0;
+    CHECK((pool.free(&not_in_pool) == nullptr));
+    CHECK((pool.free((char*)*ptrs.begin() + 1u) == nullptr));
+    CHECK((pool.free(nullptr) == nullptr));
+    CHECK((pool.alloc() == nullptr));
+
+    // the last block freed is the first allocated again
+    void* freed = *ptrs.rbegin();
+    CHECK((pool.free(freed) == nullptr));
+    CHECK((pool.alloc() == freed));
+
+    for (void* ptr : ptrs) {
+        pool.free(ptr);
+    }
+}
+
+
+TEST_CASE("Lock Free Block Pool Stress", "[LockFreeBlockPool]") {
+    const size_t thread_count = 8u;
+    const size_t live_count = 16u;
+    const size_t operation_count = 50000u;
+    static Koi::LockFreeBlockPool<64u, 128u> pool;
+
+    std::atomic<size_t> failures(0u);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0u; t < thread_count; ++t) {
+        threads.emplace_back([&failures, t, live_count, operation_count]() {
+            std::vector<unsigned char*> live(live_count, nullptr);
+
+            for (size_t i = 0u; i < operation_count; ++i) {
+                unsigned char*& ptr = live[i % live_count];
+
+                // every block is filled with its thread's id, so handing a block to 2 threads at once is caught
+                if (ptr != nullptr) {
+                    for (size_t j = 0u; j < 64u; ++j) {
+                        if (ptr[j] != (unsigned char)t) {
+                            ++failures;
+                            break;
+                        }
+                    }
+
+                    pool.free(ptr);
+                }
+
+                // there are enough blocks for every thread's live ones, so allocations never fail
+                ptr = (unsigned char*)pool.alloc();
+
+                if (ptr == nullptr) {
+                    ++failures;
+                } else {
+                    memset(ptr, (int)t, 64u);
+                }
+            }
+
+            for (unsigned char* ptr : live) {
+                pool.free(ptr);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(failures == 0u);
+
+    // every block is free again
+    size_t free_count = 0u;
+    while (pool.alloc() != nullptr) {
+        ++free_count;
+    }
+
+    CHECK(free_count == 128u);
+}
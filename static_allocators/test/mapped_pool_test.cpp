@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/mapped_pool.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+
+TEST_CASE("Mapped Pool", "[MappedPool]") {
+    koi_pool_t pool;
+    CHECK(koi_pool_map(&pool, 0u, 0u) == 0);
+    CHECK(koi_pool_map(&pool, SIZE_MAX, 0u) == 0);
+
+    // only the pages that are touched are committed, so a big pool is cheap until it is used
+    const size_t bytes = 256u * 1024u * 1024u;
+    REQUIRE(koi_pool_map(&pool, bytes, 0u) == 1);
+    CHECK(pool.block_count == bytes / KOI_BLOCK_SIZE);
+
+    char* small = (char*)koi_pool_alloc(&pool, 100u);
+    REQUIRE(small != nullptr);
+    memset(small, 'A', 100u);
+
+    char* big = (char*)koi_pool_alloc(&pool, bytes / 2u);
+    REQUIRE(big != nullptr);
+    big[0u] = 'B';
+    big[bytes / 2u - 1u] = 'B';
+
+    koi_pool_free(&pool, big);
+    koi_pool_free(&pool, small);
+
+    // once everything is freed, the whole pool can be allocated at once
+    char* all = (char*)koi_pool_alloc(&pool, (pool.block_count - 1u) * KOI_BLOCK_SIZE);
+    CHECK((all != nullptr));
+    koi_pool_free(&pool, all);
+
+    koi_pool_unmap(&pool);
+    CHECK((pool.memory == nullptr));
+}
+
+
+TEST_CASE("Mapped Pool Huge Pages", "[MappedPool]") {
+    koi_pool_t pool;
+
+    // the huge pages are only advice, so this works whether or not the OS grants them
+    REQUIRE(koi_pool_map(&pool, 8u * 1024u * 1024u + 1u, KOI_POOL_MAP_HUGE_PAGES) == 1);
+
+    char* ptr = (char*)koi_pool_alloc(&pool, 4u * 1024u * 1024u);
+    REQUIRE(ptr != nullptr);
+    CHECK(((uintptr_t)ptr % KOI_POOL_ALIGNMENT) == 0u);
+    memset(ptr, 'A', 4u * 1024u * 1024u);
+
+    koi_pool_free(&pool, ptr);
+    koi_pool_unmap(&pool);
+}
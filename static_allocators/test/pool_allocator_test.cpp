@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/pool_allocator.hpp"
+#include "static_allocators/pool_memory_resource.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <map>
+#include <new>
+#include <vector>
+
+
+TEST_CASE("Pool Allocator Containers", "[PoolAllocator]") {
+    alignas(16) static char buffer[256u * KOI_BLOCK_SIZE];
+    koi_pool_t pool;
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    Koi::PoolAllocator<int> allocator(&pool);
+    std::vector<int, Koi::PoolAllocator<int>> values(allocator);
+    std::map<int, int, std::less<int>, Koi::PoolAllocator<std::pair<const int, int>>> map(allocator);
+
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(i);
+        map[i] = i * 2;
+    }
+
+    // everything lives inside the pool's buffer
+    CHECK(((char*)values.data() >= buffer));
+    CHECK(((char*)values.data() < buffer + sizeof(buffer)));
+    CHECK(((char*)&map.at(50) >= buffer));
+    CHECK(((char*)&map.at(50) < buffer + sizeof(buffer)));
+    CHECK(values[99] == 99);
+    CHECK(map.at(99) == 198);
+
+    // rebound copies allocate from the same pool
+    CHECK((allocator == Koi::PoolAllocator<double>(allocator)));
+    CHECK((allocator != Koi::PoolAllocator<int>()));
+
+    // running out of memory throws like std::allocator
+    CHECK_THROWS_AS(values.reserve(sizeof(buffer)), std::bad_alloc);
+
+    // 0 objects get a unique pointer, like the memory resource's 0 bytes
+    int* empty = allocator.allocate(0u);
+    int* other_empty = allocator.allocate(0u);
+    CHECK((empty != nullptr));
+    CHECK((empty != other_empty));
+    allocator.deallocate(empty, 0u);
+    allocator.deallocate(other_empty, 0u);
+}
+
+
+#ifdef __cpp_lib_memory_resource
+TEST_CASE("Pool Memory Resource", "[PoolAllocator]") {
+    alignas(16) static char buffer[256u * KOI_BLOCK_SIZE];
+    koi_pool_t pool;
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    Koi::PoolMemoryResource resource(&pool);
+    std::pmr::vector<int> values(&resource);
+
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(i);
+    }
+
+    CHECK(((char*)values.data() >= buffer));
+    CHECK(((char*)values.data() < buffer + sizeof(buffer)));
+
+    // over-aligned requests are honoured
+    void* aligned = resource.allocate(100u, 64u);
+    CHECK(((uintptr_t)aligned % 64u) == 0u);
+    resource.deallocate(aligned, 100u, 64u);
+
+    Koi::PoolMemoryResource same(&pool);
+    Koi::PoolMemoryResource other;
+    CHECK(resource.is_equal(same));
+    CHECK_FALSE(resource.is_equal(other));
+
+    CHECK_THROWS_AS(resource.allocate(sizeof(buffer)), std::bad_alloc);
+}
+#endif
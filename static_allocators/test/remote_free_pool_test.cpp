@@ -0,0 +1,121 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/remote_free_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("Remote Free Pool Reuse", "[RemoteFreePool]") {
+    alignas(16) static char buffer[64u * KOI_BLOCK_SIZE];
+    Koi::RemoteFreePool pool;
+    REQUIRE(pool.init(buffer, sizeof(buffer)));
+
+    // the owner frees straight to the pool
+    void* ptr = pool.alloc(1000u);
+    REQUIRE(ptr != nullptr);
+    CHECK((pool.free(ptr) == nullptr));
+    CHECK((pool.alloc(1000u) == ptr));
+
+    // another thread's free waits in the remote free list until the owner's next allocation, and pointers outside the
+    // pool are left alone
+    void* not_in_pool = &pool;
+    std::thread([&pool, ptr, not_in_pool]() {
+        pool.free(not_in_pool);
+        pool.free(ptr);
+    }).join();
+
+    CHECK(koi_pool_get_size(pool.get_pool(), ptr) != 0u);
+    CHECK((pool.alloc(1000u) == ptr));
+    pool.free(ptr);
+
+    // once drained, the whole pool can be allocated at once
+    ptr = pool.alloc(63u * KOI_BLOCK_SIZE);
+    CHECK((ptr != nullptr));
+    pool.free(ptr);
+}
+
+
+TEST_CASE("Remote Free Pool Producer Consumer", "[RemoteFreePool]") {
+    const size_t consumer_count = 4u;
+    const size_t message_count = 100000u;
+    static char buffer[4096u * KOI_BLOCK_SIZE];
+
+    Koi::RemoteFreePool pool;
+    REQUIRE(pool.init(buffer, sizeof(buffer)));
+
+    // the owner hands each message to a consumer through a slot, and each consumer frees the messages of its slots
+    std::vector<std::atomic<unsigned char*>> slots(message_count);
+    for (std::atomic<unsigned char*>& slot : slots) {
+        slot.store(nullptr);
+    }
+
+    std::atomic<size_t> failures(0u);
+    std::vector<std::thread> consumers;
+
+    for (size_t c = 0u; c < consumer_count; ++c) {
+        consumers.emplace_back([&pool, &slots, &failures, c, consumer_count, message_count]() {
+            for (size_t i = c; i < message_count; i += consumer_count) {
+                unsigned char* message;
+                while ((message = slots[i].load(std::memory_order_acquire)) == nullptr) {
+                    std::this_thread::yield();
+                }
+
+                if (message[0u] != (unsigned char)i || message[99u] != (unsigned char)i) {
+                    ++failures;
+                }
+
+                pool.free(message);
+            }
+        });
+    }
+
+    for (size_t i = 0u; i < message_count; ++i) {
+        unsigned char* message;
+        while ((message = (unsigned char*)pool.alloc(100u)) == nullptr) {
+            std::this_thread::yield();
+        }
+
+        memset(message, (int)(unsigned char)i, 100u);
+        slots[i].store(message, std::memory_order_release);
+    }
+
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+
+    CHECK(failures == 0u);
+
+    // every message came back
+    pool.drain();
+    koi_pool_stats_t stats;
+    koi_pool_get_stats(pool.get_pool(), &stats);
+    CHECK(stats.bytes_in_use == 0u);
+}
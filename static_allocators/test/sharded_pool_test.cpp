@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/sharded_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("Sharded Pool Stealing", "[ShardedPool]") {
+    alignas(16) static char buffer[4u * 64u * KOI_BLOCK_SIZE];
+    Koi::ShardedPool pool;
+    CHECK_FALSE(pool.init(buffer, sizeof(buffer), KOI_SHARDED_POOL_MAX_SHARDS + 1u));
+    REQUIRE(pool.init(buffer, sizeof(buffer), 4u));
+    CHECK(pool.get_shard_count() == 4u);
+
+    // each shard only fits 1 of these, so allocating 4 steals from every other shard and a 5th fails
+    void* ptrs[4u];
+    for (void*& ptr : ptrs) {
+        ptr = pool.alloc(40u * KOI_BLOCK_SIZE);
+        REQUIRE(ptr != nullptr);
+        memset(ptr, 'A', 40u * KOI_BLOCK_SIZE);
+    }
+
+    CHECK((pool.alloc(40u * KOI_BLOCK_SIZE) == nullptr));
+
+    // nothing is bigger than a shard
+    CHECK((pool.alloc(64u * KOI_BLOCK_SIZE) == nullptr));
+
+    // pointers outside the pool are ignored
+    int not_in_pool = 0;
+    CHECK((pool.free(&not_in_pool) == nullptr));
+    CHECK((pool.free(nullptr) == nullptr));
+
+    // frees go back to the shard that owns the memory, whichever thread frees
+    std::thread([&pool, &ptrs]() {
+        CHECK((pool.free(ptrs[2u]) == nullptr));
+    }).join();
+
+    char* ptr = (char*)pool.calloc(40u, KOI_BLOCK_SIZE);
+    CHECK((ptr == ptrs[2u]));
+    CHECK(ptr[0u] == '\0');
+    CHECK(ptr[40u * KOI_BLOCK_SIZE - 1u] == '\0');
+
+    for (void* p : ptrs) {
+        pool.free(p);
+    }
+}
+
+
+TEST_CASE("Sharded Pool Stress", "[ShardedPool]") {
+    const size_t thread_count = 8u;
+    const size_t live_count = 64u;
+    const size_t operation_count = 20000u;
+    static char buffer[16384u * KOI_BLOCK_SIZE];
+
+    Koi::ShardedPool pool;
+    REQUIRE(pool.init(buffer, sizeof(buffer), 4u));
+
+    std::atomic<size_t> failures(0u);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0u; t < thread_count; ++t) {
+        threads.emplace_back([&pool, &failures, t, live_count, operation_count]() {
+            std::mt19937 random((unsigned)t);
+            std::uniform_int_distribution<size_t> pick_size(1u, 1024u);
+            std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+
+            std::vector<unsigned char*> live(live_count, nullptr);
+            std::vector<size_t> sizes(live_count, 0u);
+
+            for (size_t i = 0u; i < operation_count; ++i) {
+                size_t slot = pick_slot(random);
+
+                // every allocation is filled with its thread's id, so sharing memory between threads is caught
+                if (live[slot] != nullptr) {
+                    for (size_t j = 0u; j < sizes[slot]; ++j) {
+                        if (live[slot][j] != (unsigned char)t) {
+                            ++failures;
+                            break;
+                        }
+                    }
+
+                    pool.free(live[slot]);
+                }
+
+                sizes[slot] = pick_size(random);
+                live[slot] = (unsigned char*)pool.alloc(sizes[slot]);
+
+                if (live[slot] == nullptr) {
+                    ++failures;
+                } else {
+                    memset(live[slot], (int)t, sizes[slot]);
+                }
+            }
+
+            for (unsigned char* ptr : live) {
+                pool.free(ptr);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(failures == 0u);
+}
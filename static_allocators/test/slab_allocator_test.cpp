@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/slab_allocator.h"
+#include "static_allocators/object_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+
+TEST_CASE("Slab Allocations", "[Slab]") {
+    koi_slab_t slab;
+    char buffer[4u * sizeof(void*) * 3u + 1u];
+
+    CHECK(koi_slab_init(&slab, buffer, sizeof(buffer), 3u * sizeof(void*), 3u) == 0);
+
+    // sizes so big that rounding them up to the alignment would wrap around fail instead
+    CHECK(koi_slab_init(&slab, buffer, sizeof(buffer), SIZE_MAX, 8u) == 0);
+    CHECK(koi_slab_init(&slab, buffer, sizeof(buffer), SIZE_MAX - 1u, 64u) == 0);
+    REQUIRE(koi_slab_init(&slab, buffer + 1u, sizeof(buffer) - 1u, 3u * sizeof(void*), 1u) == 1);
+
+    // the buffer was unaligned, so the padding costs 1 object
+    char* objects[3u];
+    for (char*& object : objects) {
+        object = (char*)koi_slab_alloc(&slab);
+        REQUIRE(object != nullptr);
+        CHECK((uintptr_t)object % sizeof(void*) == 0u);
+    }
+
+    CHECK((koi_slab_alloc(&slab) == nullptr));
+
+    // objects that aren't from the slab, or are misaligned within it, are ignored
+    int not_in_slab = 0;
+    koi_slab_free(&slab, &not_in_slab);
+    koi_slab_free(&slab, objects[1u] + 1u);
+    CHECK((koi_slab_alloc(&slab) == nullptr));
+
+    objects[1u][0u] = 'A';
+    koi_slab_free(&slab, objects[1u]);
+    koi_slab_free(&slab, objects[0u]);
+
+    // the most recently freed object is reused first, zeroed when asked for
+    char* object = (char*)koi_slab_alloc(&slab);
+    CHECK((object == objects[0u]));
+    object = (char*)koi_slab_calloc(&slab);
+    CHECK((object == objects[1u]));
+    CHECK(object[0u] == '\0');
+}
+
+
+namespace {
+
+struct Envelope {
+    static int alive;
+
+    uint64_t channel;
+    double payload;
+
+    Envelope(uint64_t channel, double payload): channel(channel), payload(payload) {
+        if (payload < 0.0) {
+            throw std::invalid_argument("negative payload");
+        }
+
+        ++alive;
+    }
+
+    ~Envelope() { --alive; }
+};
+
+int Envelope::alive = 0;
+
+struct alignas(32) Vector8 {
+    float values[8u];
+};
+
+}
+
+
+TEST_CASE("Object Pool", "[Slab]") {
+    Koi::ObjectPool<Envelope, 2u> pool;
+
+    // small objects cost exactly their own size
+    CHECK(Koi::ObjectPool<Envelope, 2u>::stride == sizeof(Envelope));
+
+    Envelope* first = pool.create(7u, 0.5);
+    Envelope* second = pool.create(8u, 1.5);
+
+    REQUIRE(first != nullptr);
+    REQUIRE(second != nullptr);
+    CHECK(first->channel == 7u);
+    CHECK(second->payload == 1.5);
+    CHECK(Envelope::alive == 2);
+    CHECK((pool.create(9u, 2.5) == nullptr));
+
+    pool.destroy(first);
+    CHECK(Envelope::alive == 1);
+
+    Envelope* third = pool.create(9u, 2.5);
+    CHECK((third == first));
+    CHECK(third->channel == 9u);
+
+    pool.destroy(second);
+    pool.destroy(third);
+    pool.destroy(nullptr);
+    CHECK(Envelope::alive == 0);
+
+    // a constructor that throws gives its memory back to the pool
+    for (size_t i = 0u; i < 4u; ++i) {
+        CHECK_THROWS_AS(pool.create(10u, -1.0), std::invalid_argument);
+    }
+
+    first = pool.create(10u, 1.0);
+    second = pool.create(11u, 1.0);
+    CHECK(first != nullptr);
+    CHECK(second != nullptr);
+    pool.destroy(first);
+    pool.destroy(second);
+    CHECK(Envelope::alive == 0);
+
+    Koi::ObjectPool<Vector8, 4u> vectors;
+    for (size_t i = 0u; i < 4u; ++i) {
+        Vector8* vector = vectors.create();
+        REQUIRE(vector != nullptr);
+        CHECK((uintptr_t)vector % 32u == 0u);
+    }
+}
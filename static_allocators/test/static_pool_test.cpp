@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/static_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+
+TEST_CASE("Static Pool Allocations", "[StaticPool]") {
+    // differently configured pools live side by side, each with its own geometry
+    static Koi::StaticPool<4096u> pool;
+    static Koi::StaticPool<1u << 20u, 64u> big_pool;
+    STATIC_REQUIRE(Koi::StaticPool<4096u>::block_size == alignof(std::max_align_t));
+    STATIC_REQUIRE(Koi::StaticPool<1u << 20u, 64u>::block_count == (1u << 20u) / 64u);
+
+    CHECK((pool.alloc(0u) == nullptr));
+    CHECK((pool.alloc(4096u) == nullptr));
+
+    char* first = (char*)pool.alloc(100u);
+    char* second = (char*)pool.alloc(100u);
+    REQUIRE(first != nullptr);
+    REQUIRE(second != nullptr);
+    CHECK(((uintptr_t)first % alignof(std::max_align_t)) == 0u);
+    memset(first, 'A', 100u);
+    memset(second, 'B', 100u);
+
+    const size_t block_size = Koi::StaticPool<4096u>::block_size;
+    size_t first_size = pool.get_size(first);
+    CHECK(first_size == (100u + block_size - 1u) / block_size * block_size);
+    CHECK((second == first + first_size + block_size));
+
+    char* aligned = (char*)big_pool.alloc(1u);
+    REQUIRE(aligned != nullptr);
+    CHECK(((uintptr_t)aligned % 64u) == 0u);
+    big_pool.free(aligned);
+
+    // pointers that aren't allocations are ignored
+    int not_in_pool = 0;
+    CHECK((pool.free(&not_in_pool) == nullptr));
+    CHECK((pool.free(first + block_size) == nullptr));
+    CHECK(pool.get_size(first) == first_size);
+
+    // freeing in any order merges everything back into 1 section
+    CHECK((pool.free(first) == nullptr));
+    CHECK(pool.get_size(first) == 0u);
+    pool.free(first);
+    pool.free(second);
+
+    char* all = (char*)pool.alloc((Koi::StaticPool<4096u>::block_count - 1u) * block_size);
+    CHECK((all == first));
+    pool.free(all);
+}
+
+
+template<typename Policy>
+static void check_policy(size_t expected_hole) {
+    static Koi::StaticPool<64u * 64u, 64u, Policy> pool;
+    const size_t block_size = 64u;
+
+    // leave a hole of 10 blocks, then a hole of 8, with the rest of the pool free after them
+    char* holes[2u];
+    holes[0u] = (char*)pool.alloc(10u * block_size);
+    char* first_separator = (char*)pool.alloc(block_size);
+    holes[1u] = (char*)pool.alloc(8u * block_size);
+    char* second_separator = (char*)pool.alloc(block_size);
+    REQUIRE(second_separator != nullptr);
+
+    pool.free(holes[0u]);
+    pool.free(holes[1u]);
+
+    char* ptr = (char*)pool.alloc(8u * block_size);
+    if (expected_hole < 2u) {
+        CHECK((ptr == holes[expected_hole]));
+    } else {
+        CHECK((ptr == second_separator + 2u * block_size));
+    }
+
+    pool.free(ptr);
+    pool.free(first_separator);
+    pool.free(second_separator);
+
+    ptr = (char*)pool.alloc(63u * block_size);
+    CHECK((ptr != nullptr));
+    pool.free(ptr);
+}
+
+
+TEST_CASE("Static Pool Fit Policies", "[StaticPool]") {
+    check_policy<Koi::FirstFit>(0u);
+    check_policy<Koi::BestFit>(1u);
+
+    // next fit carries on after the last allocation
+    check_policy<Koi::NextFit>(2u);
+}
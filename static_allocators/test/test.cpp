@@ -29,6 +29,9 @@
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstdint>
+#include <cstring>
+
 
 const size_t m5_size = 7u;
 typedef struct test_struct_t {
@@ -47,7 +50,9 @@ TEST_CASE("1 Allocation", "[Allocator]") {
 
     ptr = (char*)koi_static_alloc(15u * koi_static_get_block_size());
 
+    // the static memory pool is aligned, so none of it is skipped to align the data
     CHECK((ptr != nullptr));
+    CHECK(((uintptr_t)ptr % KOI_POOL_ALIGNMENT) == 0u);
 
     ptr = (char*)koi_static_free(ptr);
 
@@ -74,6 +79,425 @@ TEST_CASE("2 Allocations", "[Allocator]") {
 }
 
 
+TEST_CASE("Free Out Of Order", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    char* ptrs[7u];
+
+    for (size_t i = 0u; i < 7u; ++i) {
+        ptrs[i] = (char*)koi_static_alloc(block_size);
+        REQUIRE(ptrs[i] != nullptr);
+    }
+
+    char* second = ptrs[1u];
+    ptrs[1u] = (char*)koi_static_free(ptrs[1u]);
+    ptrs[3u] = (char*)koi_static_free(ptrs[3u]);
+    ptrs[2u] = (char*)koi_static_free(ptrs[2u]);
+
+    // the holes merged into 1 section with room for their 3 blocks of data + 2 of the freed headers
+    char* merged = (char*)koi_static_alloc(5u * block_size);
+    CHECK((merged == second));
+    merged = (char*)koi_static_free(merged);
+
+    for (size_t i = 0u; i < 7u; ++i) {
+        ptrs[i] = (char*)koi_static_free(ptrs[i]);
+    }
+
+    char* ptr = (char*)koi_static_alloc(15u * block_size);
+    CHECK((ptr != nullptr));
+    ptr = (char*)koi_static_free(ptr);
+    CHECK((ptr == nullptr));
+}
+
+
+TEST_CASE("Free Invalid Pointer", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    char* ptr = (char*)koi_static_alloc(2u * block_size);
+    REQUIRE(ptr != nullptr);
+
+    int not_in_pool = 0;
+    CHECK((koi_static_free(&not_in_pool) == nullptr));
+    CHECK((koi_static_free(ptr + 1u) == nullptr));
+
+    // the pool still knows the allocation is live, so the rest of the pool can't be allocated as 1 section
+    CHECK((koi_static_alloc(15u * block_size) == nullptr));
+
+    char* freed = ptr;
+    ptr = (char*)koi_static_free(ptr);
+
+    // freeing twice does nothing either
+    CHECK((koi_static_free(freed) == nullptr));
+
+    ptr = (char*)koi_static_alloc(15u * block_size);
+    CHECK((ptr != nullptr));
+    ptr = (char*)koi_static_free(ptr);
+}
+
+
+TEST_CASE("Free Pointer Inside Allocation", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    koi_pool_t pool;
+    char buffer[16u * KOI_BLOCK_SIZE];
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    char* ptr = (char*)koi_pool_alloc(&pool, 8u * block_size);
+    REQUIRE(ptr != nullptr);
+
+    // every word of each block holds the address of the block after it, so the data looks like the header of an
+    // allocation starting there
+    for (size_t i = 0u; i < 7u; ++i) {
+        char* next = ptr + (i + 1u) * block_size;
+        for (size_t j = 0u; j < block_size / sizeof(char*); ++j) {
+            memcpy(ptr + i * block_size + j * sizeof(char*), &next, sizeof(char*));
+        }
+    }
+
+    for (size_t i = 1u; i < 8u; ++i) {
+        CHECK((koi_pool_free(&pool, ptr + i * block_size) == nullptr));
+        CHECK(koi_pool_get_size(&pool, ptr + i * block_size) == 0u);
+    }
+
+    // the allocation is still whole
+    CHECK(koi_pool_get_size(&pool, ptr) == 8u * block_size);
+    CHECK((koi_pool_alloc(&pool, (pool.block_count - 1u) * block_size) == nullptr));
+}
+
+
+TEST_CASE("Small Allocation Reuse", "[Allocator]") {
+    char* ptr = (char*)koi_static_alloc(100u);
+    REQUIRE(ptr != nullptr);
+    memset(ptr, 'A', 100u);
+
+    char* freed = ptr;
+    ptr = (char*)koi_static_free(ptr);
+    ptr = (char*)koi_static_alloc(100u);
+
+    // freed allocations of the same size are reused
+    CHECK((ptr == freed));
+    ptr = (char*)koi_static_free(ptr);
+
+    // and zeroed when asked for
+    ptr = (char*)koi_static_calloc(10u, 10u);
+    CHECK((ptr == freed));
+    for (size_t i = 0u; i < 100u; ++i) {
+        CHECK(ptr[i] == '\0');
+    }
+
+    ptr = (char*)koi_static_free(ptr);
+
+    // the total size overflowing fails instead of allocating too little
+    CHECK((koi_static_calloc(SIZE_MAX / 2u, 4u) == nullptr));
+}
+
+
+TEST_CASE("Huge Allocation", "[Allocator]") {
+    // sizes so big that rounding them up to whole blocks would wrap around fail instead
+    CHECK((koi_static_alloc(SIZE_MAX - 10u) == nullptr));
+    CHECK((koi_static_alloc(SIZE_MAX) == nullptr));
+    CHECK((koi_static_alloc_aligned(SIZE_MAX - 10u, 64u) == nullptr));
+
+    void* batch[2u] = {nullptr, nullptr};
+    CHECK(koi_static_alloc_batch(SIZE_MAX - 10u, 2u, batch) == 0);
+    CHECK((batch[0u] == nullptr));
+
+    // a failed realloc leaves the allocation as it was
+    koi_pool_t pool;
+    char buffer[16u * KOI_BLOCK_SIZE];
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    char* ptr = (char*)koi_pool_alloc(&pool, 100u);
+    REQUIRE(ptr != nullptr);
+    memset(ptr, 'A', 100u);
+    CHECK((koi_pool_realloc(&pool, ptr, SIZE_MAX - 10u) == nullptr));
+    CHECK(koi_pool_get_size(&pool, ptr) >= 100u);
+    CHECK(ptr[99u] == 'A');
+    ptr = (char*)koi_pool_free(&pool, ptr);
+
+    // and the memory pool is still whole
+    ptr = (char*)koi_pool_alloc(&pool, (pool.block_count - 1u) * koi_static_get_block_size());
+    CHECK((ptr != nullptr));
+}
+
+
+TEST_CASE("Independent Pools", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    koi_pool_t first;
+    koi_pool_t second;
+    alignas(16) char first_buffer[8u * KOI_BLOCK_SIZE];
+    char second_buffer[8u * KOI_BLOCK_SIZE + 1u];
+
+    CHECK(koi_pool_init(&first, first_buffer, block_size) == 0);
+    REQUIRE(koi_pool_init(&first, first_buffer, sizeof(first_buffer)) == 1);
+
+    // the buffer doesn't need to be aligned
+    REQUIRE(koi_pool_init(&second, second_buffer + 1u, sizeof(second_buffer) - 1u) == 1);
+
+    char* ptr = (char*)koi_pool_alloc(&first, 6u * block_size);
+    char* ptr2 = (char*)koi_pool_alloc(&second, 6u * block_size);
+
+    CHECK((ptr != nullptr));
+    CHECK((ptr2 != nullptr));
+    CHECK((koi_pool_alloc(&first, block_size) == nullptr));
+
+    // freeing through the wrong pool does nothing
+    koi_pool_free(&second, ptr);
+    CHECK((koi_pool_alloc(&first, 6u * block_size) == nullptr));
+
+    ptr = (char*)koi_pool_free(&first, ptr);
+    ptr2 = (char*)koi_pool_free(&second, ptr2);
+
+    ptr = (char*)koi_pool_alloc(&first, 7u * block_size);
+    CHECK((ptr != nullptr));
+}
+
+
+TEST_CASE("Aligned Allocation", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    koi_pool_t pool;
+    // 1024 is a multiple of KOI_POOL_ALIGNMENT, so a 1024 aligned block can be up to 1024 / KOI_POOL_ALIGNMENT blocks in
+    char buffer[128u * KOI_BLOCK_SIZE];
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    CHECK((koi_pool_alloc_aligned(&pool, block_size, 0u) == nullptr));
+    CHECK((koi_pool_alloc_aligned(&pool, block_size, 48u) == nullptr));
+
+    char* ptrs[4u];
+    size_t alignments[4u] = { 32u, 64u, 128u, 256u };
+
+    for (size_t i = 0u; i < 4u; ++i) {
+        ptrs[i] = (char*)koi_pool_alloc_aligned(&pool, 100u, alignments[i]);
+        REQUIRE(ptrs[i] != nullptr);
+        CHECK(((uintptr_t)ptrs[i] % alignments[i]) == 0u);
+        memset(ptrs[i], 'A', 100u);
+    }
+
+    // the blocks skipped for alignment are still free for other allocations
+    char* small = (char*)koi_pool_alloc(&pool, block_size);
+    CHECK((small != nullptr));
+#if KOI_FIT_POLICY != KOI_FIT_NEXT
+    CHECK((small < ptrs[3u]));
+#endif
+
+    // freeing in any order merges the padding back, so the whole pool is 1 section again
+    ptrs[2u] = (char*)koi_pool_free(&pool, ptrs[2u]);
+    ptrs[0u] = (char*)koi_pool_free(&pool, ptrs[0u]);
+    small = (char*)koi_pool_free(&pool, small);
+    ptrs[3u] = (char*)koi_pool_free(&pool, ptrs[3u]);
+    ptrs[1u] = (char*)koi_pool_free(&pool, ptrs[1u]);
+
+    // with size classes, the small allocations are parked until a big allocation fails, then merge back
+    char* ptr = (char*)koi_pool_alloc(&pool, (pool.block_count - 1u) * block_size);
+    CHECK((ptr != nullptr));
+    ptr = (char*)koi_pool_free(&pool, ptr);
+
+    // a big alignment still fits when the pool is big enough
+    ptr = (char*)koi_pool_alloc_aligned(&pool, block_size, 1024u);
+    CHECK((ptr != nullptr));
+    CHECK(((uintptr_t)ptr % 1024u) == 0u);
+    ptr = (char*)koi_pool_free(&pool, ptr);
+
+    ptr = (char*)koi_static_alloc_aligned(block_size, 64u);
+    CHECK((ptr != nullptr));
+    CHECK(((uintptr_t)ptr % 64u) == 0u);
+    ptr = (char*)koi_static_free(ptr);
+}
+
+
+TEST_CASE("Realloc", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    koi_pool_t pool;
+    char buffer[64u * KOI_BLOCK_SIZE];
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    char* ptr = (char*)koi_pool_realloc(&pool, nullptr, 8u * block_size);
+    REQUIRE(ptr != nullptr);
+    memset(ptr, 'A', 8u * block_size);
+
+    // grows into the free section after it
+    char* grown = (char*)koi_pool_realloc(&pool, ptr, 12u * block_size);
+    CHECK((grown == ptr));
+    CHECK(koi_pool_get_size(&pool, ptr) == 12u * block_size);
+
+    // shrinks by giving the tail back, so the next allocation starts right after it
+    char* shrunk = (char*)koi_pool_realloc(&pool, ptr, 8u * block_size);
+    CHECK((shrunk == ptr));
+    CHECK(koi_pool_get_size(&pool, ptr) == 8u * block_size);
+
+    char* next = (char*)koi_pool_alloc(&pool, 8u * block_size);
+    CHECK((next == ptr + 9u * block_size));
+
+    // moves when the next section is taken, keeping the bytes
+    char* moved = (char*)koi_pool_realloc(&pool, ptr, 12u * block_size);
+    REQUIRE(moved != nullptr);
+    CHECK((moved != ptr));
+    for (size_t i = 0u; i < 8u * block_size; ++i) {
+        CHECK(moved[i] == 'A');
+    }
+
+    // the old section was freed. Next fit carries on after the last allocation instead of reusing it first
+#if KOI_FIT_POLICY == KOI_FIT_NEXT
+    CHECK(koi_pool_get_size(&pool, ptr) == 0u);
+#else
+    CHECK((koi_pool_alloc(&pool, 8u * block_size) == ptr));
+#endif
+
+    // fails without touching the allocation if there isn't enough memory
+    CHECK((koi_pool_realloc(&pool, moved, 64u * block_size) == nullptr));
+    CHECK(koi_pool_get_size(&pool, moved) == 12u * block_size);
+
+    int not_in_pool = 0;
+    CHECK((koi_pool_realloc(&pool, &not_in_pool, block_size) == nullptr));
+
+    // a size of 0 frees
+    CHECK((koi_pool_realloc(&pool, moved, 0u) == nullptr));
+    CHECK(koi_pool_get_size(&pool, moved) == 0u);
+}
+
+
+// these need allocations of 7 blocks or more to skip the size classes, as they do up to the default maximum size
+#if KOI_SIZE_CLASS_MAX_SIZE <= 256u
+TEST_CASE("Fit Policy", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    koi_pool_t pool;
+    char buffer[64u * KOI_BLOCK_SIZE];
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    // leave a hole of 10 blocks, then a hole of 8, with the rest of the pool free after them. Each allocation is too
+    // big for the size classes
+    char* first_hole = (char*)koi_pool_alloc(&pool, 10u * block_size);
+    char* first_separator = (char*)koi_pool_alloc(&pool, 7u * block_size);
+    char* second_hole = (char*)koi_pool_alloc(&pool, 8u * block_size);
+    char* second_separator = (char*)koi_pool_alloc(&pool, 7u * block_size);
+    REQUIRE(second_separator != nullptr);
+
+    koi_pool_free(&pool, first_hole);
+    koi_pool_free(&pool, second_hole);
+
+    char* ptr = (char*)koi_pool_alloc(&pool, 8u * block_size);
+#if KOI_FIT_POLICY == KOI_FIT_NEXT
+    CHECK((ptr == second_separator + 8u * block_size));
+#elif KOI_FIT_POLICY == KOI_FIT_BEST
+    CHECK((ptr == second_hole));
+#else
+    CHECK((ptr == first_hole));
+#endif
+
+    koi_pool_free(&pool, ptr);
+    koi_pool_free(&pool, first_separator);
+    koi_pool_free(&pool, second_separator);
+
+    // every policy merges the holes back, so the whole pool is 1 section again
+    ptr = (char*)koi_pool_alloc(&pool, (pool.block_count - 1u) * block_size);
+    CHECK((ptr != nullptr));
+    koi_pool_free(&pool, ptr);
+}
+#endif
+
+
+TEST_CASE("Batch Allocation", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    koi_pool_t pool;
+    char buffer[64u * KOI_BLOCK_SIZE];
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    void* ptrs[8u];
+    CHECK(koi_pool_alloc_batch(&pool, 0u, 8u, ptrs) == 0);
+    CHECK(koi_pool_alloc_batch(&pool, block_size, 0u, ptrs) == 0);
+    CHECK(koi_pool_alloc_batch(&pool, SIZE_MAX / 2u, 8u, ptrs) == 0);
+
+    // the allocations are carved from 1 section, each right after the one before it
+    REQUIRE(koi_pool_alloc_batch(&pool, block_size, 8u, ptrs) == 1);
+    for (size_t i = 1u; i < 8u; ++i) {
+        CHECK(((char*)ptrs[i] == (char*)ptrs[i - 1u] + 2u * block_size));
+        CHECK(koi_pool_get_size(&pool, ptrs[i]) == block_size);
+    }
+
+    // each can be freed on its own
+    char* freed = (char*)ptrs[3u];
+    koi_pool_free(&pool, freed);
+    ptrs[3u] = nullptr;
+
+    // fails without allocating anything if there isn't a section big enough for all of them
+    void* too_many[32u] = {nullptr};
+    CHECK(koi_pool_alloc_batch(&pool, block_size, 32u, too_many) == 0);
+    CHECK((too_many[0u] == nullptr));
+
+    // the rest are freed out of order with a repeat and pointers that aren't allocations, and merge back into 1 section
+    int not_in_pool = 0;
+    void* to_free[10u] = {ptrs[7u], ptrs[0u], &not_in_pool, ptrs[5u], ptrs[1u], ptrs[3u], ptrs[2u], ptrs[6u], ptrs[4u],
+                          ptrs[0u]};
+    koi_pool_free_batch(&pool, to_free, 10u);
+
+    for (size_t i = 0u; i < 8u; ++i) {
+        CHECK(koi_pool_get_size(&pool, ptrs[i]) == 0u);
+    }
+
+    // the failed batch flushed the allocation freed on its own from its size class, so everything is 1 section again
+    koi_pool_stats_t stats;
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(stats.bytes_in_use == 0u);
+    CHECK(stats.largest_free_segment == (pool.block_count - 1u) * block_size);
+}
+
+
+#if KOI_SIZE_CLASS_MAX_SIZE <= 256u
+TEST_CASE("Pool Stats", "[Allocator]") {
+    size_t block_size = koi_static_get_block_size();
+    koi_pool_t pool;
+    koi_pool_stats_t stats;
+    char buffer[32u * KOI_BLOCK_SIZE];
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    size_t capacity = (pool.block_count - 1u) * block_size;
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(stats.bytes_in_use == 0u);
+    CHECK(stats.free_bytes == capacity);
+    CHECK(stats.free_segments == 1u);
+    CHECK(stats.largest_free_segment == capacity);
+    CHECK(stats.fragmentation == 0.0);
+
+    char* ptrs[3u];
+    for (size_t i = 0u; i < 3u; ++i) {
+        ptrs[i] = (char*)koi_pool_alloc(&pool, 8u * block_size);
+        REQUIRE(ptrs[i] != nullptr);
+    }
+
+    // freeing the middle allocation leaves 2 free sections
+    ptrs[1u] = (char*)koi_pool_free(&pool, ptrs[1u]);
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(stats.bytes_in_use == 16u * block_size);
+    CHECK(stats.free_segments == 2u);
+    CHECK(stats.largest_free_segment == 8u * block_size);
+    CHECK(stats.free_bytes == capacity - 19u * block_size);
+    CHECK(stats.fragmentation > 0.0);
+
+    // small allocations parked in a size class aren't in use
+    char* small = (char*)koi_pool_alloc(&pool, block_size);
+    small = (char*)koi_pool_free(&pool, small);
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(stats.bytes_in_use == 16u * block_size);
+    CHECK(stats.size_class_bytes == (KOI_SIZE_CLASS_MAX_SIZE > 0u ? block_size : 0u));
+
+    // the static memory pool is empty between test cases
+    koi_static_get_stats(&stats);
+    CHECK(stats.bytes_in_use == 0u);
+
+    CHECK((koi_pool_alloc(&pool, capacity) == nullptr));
+
+#if KOI_POOL_STATS
+    koi_pool_get_stats(&pool, &stats);
+    CHECK(stats.high_water_mark == 24u * block_size);
+    CHECK(stats.failure_count == 1u);
+
+    size_t searches = 0u;
+    for (size_t i = 0u; i < KOI_POOL_STATS_SEARCH_BUCKETS; ++i) {
+        searches += stats.search_lengths[i];
+    }
+    CHECK(searches > 0u);
+#endif
+}
+#endif
+
+
 TEST_CASE("TestStruct", "[Allocator]") {
     TestStruct values {
             80,
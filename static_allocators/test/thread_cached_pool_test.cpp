@@ -0,0 +1,157 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/thread_cached_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("Thread Cached Pool Reuse", "[ThreadCachedPool]") {
+    alignas(16) static char buffer[64u * KOI_BLOCK_SIZE];
+    Koi::ThreadCachedPool pool;
+    REQUIRE(pool.init(buffer, sizeof(buffer)));
+
+    char* ptr = (char*)pool.alloc(100u);
+    REQUIRE(ptr != nullptr);
+    memset(ptr, 'A', 100u);
+
+    char* freed = ptr;
+    ptr = (char*)pool.free(ptr);
+    CHECK((ptr == nullptr));
+
+    // the same thread gets its freed allocation back from its cache, zeroed when asked for
+    ptr = (char*)pool.calloc(100u, 1u);
+    CHECK((ptr == freed));
+    CHECK(ptr[0u] == '\0');
+    CHECK(ptr[99u] == '\0');
+
+    ptr = (char*)pool.free(ptr);
+
+    // sizes so big that rounding them up to whole blocks would wrap around fail instead
+    CHECK((pool.alloc(SIZE_MAX - 10u) == nullptr));
+    CHECK((pool.calloc(1u, SIZE_MAX) == nullptr));
+
+    pool.flush();
+
+    // once flushed, the whole pool can be allocated at once
+    ptr = (char*)pool.alloc(63u * KOI_BLOCK_SIZE);
+    CHECK((ptr != nullptr));
+    ptr = (char*)pool.free(ptr);
+}
+
+
+#ifndef NDEBUG
+TEST_CASE("Thread Cached Pool Double Free", "[ThreadCachedPool]") {
+    alignas(16) static char buffer[64u * KOI_BLOCK_SIZE];
+    Koi::ThreadCachedPool pool;
+    REQUIRE(pool.init(buffer, sizeof(buffer)));
+
+    void* ptr = pool.alloc(100u);
+    REQUIRE(ptr != nullptr);
+    pool.free(ptr);
+    pool.free(ptr);
+
+    // debug builds cache the allocation only once, so 2 allocations don't share it
+    void* first = pool.alloc(100u);
+    void* second = pool.alloc(100u);
+    CHECK((first == ptr));
+    CHECK((second != ptr));
+
+    pool.free(first);
+    pool.free(second);
+    pool.flush();
+}
+#endif
+
+
+TEST_CASE("Thread Cached Pool Stress", "[ThreadCachedPool]") {
+    const size_t thread_count = 8u;
+    const size_t live_count = 64u;
+    const size_t operation_count = 20000u;
+    static char buffer[16384u * KOI_BLOCK_SIZE];
+
+    Koi::ThreadCachedPool pool;
+    REQUIRE(pool.init(buffer, sizeof(buffer)));
+
+    std::atomic<size_t> failures(0u);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0u; t < thread_count; ++t) {
+        threads.emplace_back([&pool, &failures, t, live_count, operation_count]() {
+            std::mt19937 random((unsigned)t);
+            std::uniform_int_distribution<size_t> pick_size(1u, 512u);
+            std::uniform_int_distribution<size_t> pick_slot(0u, live_count - 1u);
+
+            std::vector<unsigned char*> live(live_count, nullptr);
+            std::vector<size_t> sizes(live_count, 0u);
+
+            for (size_t i = 0u; i < operation_count; ++i) {
+                size_t slot = pick_slot(random);
+
+                // every allocation is filled with its thread's id, so sharing memory between threads is caught
+                if (live[slot] != nullptr) {
+                    for (size_t j = 0u; j < sizes[slot]; ++j) {
+                        if (live[slot][j] != (unsigned char)t) {
+                            ++failures;
+                            break;
+                        }
+                    }
+
+                    pool.free(live[slot]);
+                }
+
+                sizes[slot] = pick_size(random);
+                live[slot] = (unsigned char*)pool.alloc(sizes[slot]);
+
+                if (live[slot] == nullptr) {
+                    ++failures;
+                } else {
+                    memset(live[slot], (int)t, sizes[slot]);
+                }
+            }
+
+            for (unsigned char* ptr : live) {
+                pool.free(ptr);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(failures == 0u);
+
+    // every thread returned its cache when it exited
+    void* ptr = pool.alloc(sizeof(buffer) - 2u * KOI_BLOCK_SIZE);
+    CHECK((ptr != nullptr));
+    pool.free(ptr);
+}
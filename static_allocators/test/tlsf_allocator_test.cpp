@@ -0,0 +1,148 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/tlsf_allocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+TEST_CASE("TLSF Allocations", "[TLSF]") {
+    koi_tlsf_t tlsf;
+    char tiny[4u * sizeof(void*)];
+    CHECK(koi_tlsf_init(&tlsf, tiny, sizeof(tiny)) == 0);
+
+    static char buffer[4096u + 1u];
+    REQUIRE(koi_tlsf_init(&tlsf, buffer + 1u, sizeof(buffer) - 1u) == 1);
+
+    // everything but the headers of the free block and of the block at the end is 1 block, but allocations are rounded
+    // up to the next list's size, so only sizes in the list below it are guaranteed to find it
+    size_t biggest = tlsf.bytes - 2u * koi_tlsf_get_header_size();
+    CHECK((koi_tlsf_alloc(&tlsf, biggest + 1u) == nullptr));
+
+    size_t big = biggest / 16u * 15u;
+    char* ptr = (char*)koi_tlsf_alloc(&tlsf, big);
+    REQUIRE(ptr != nullptr);
+    CHECK((uintptr_t)ptr % (2u * sizeof(void*)) == 0u);
+    CHECK((koi_tlsf_alloc(&tlsf, big) == nullptr));
+    ptr = (char*)koi_tlsf_free(&tlsf, ptr);
+
+    char* first = (char*)koi_tlsf_alloc(&tlsf, 100u);
+    char* second = (char*)koi_tlsf_alloc(&tlsf, 1000u);
+    char* third = (char*)koi_tlsf_alloc(&tlsf, 10u);
+
+    REQUIRE(first != nullptr);
+    REQUIRE(second != nullptr);
+    REQUIRE(third != nullptr);
+
+    // pointers inside an allocation, or already freed, are ignored
+    koi_tlsf_free(&tlsf, second + 2u * sizeof(void*));
+    koi_tlsf_free(&tlsf, second);
+    koi_tlsf_free(&tlsf, second);
+    koi_tlsf_free(&tlsf, first);
+    koi_tlsf_free(&tlsf, third);
+
+    // every block merged back
+    ptr = (char*)koi_tlsf_alloc(&tlsf, big);
+    CHECK((ptr != nullptr));
+    koi_tlsf_free(&tlsf, ptr);
+}
+
+
+TEST_CASE("TLSF Random Allocations", "[TLSF]") {
+    static char buffer[1024u * 1024u];
+    koi_tlsf_t tlsf;
+    REQUIRE(koi_tlsf_init(&tlsf, buffer, sizeof(buffer)) == 1);
+
+    std::mt19937 random(5u);
+    std::uniform_int_distribution<size_t> pick_size(1u, 4000u);
+    std::vector<unsigned char*> live(128u, nullptr);
+    std::vector<size_t> sizes(128u, 0u);
+    size_t corrupted = 0u;
+    size_t failures = 0u;
+
+    for (size_t i = 0u; i < 50000u; ++i) {
+        size_t slot = random() % live.size();
+
+        if (live[slot] != nullptr) {
+            for (size_t j = 0u; j < sizes[slot]; ++j) {
+                corrupted += live[slot][j] != (unsigned char)slot;
+            }
+
+            koi_tlsf_free(&tlsf, live[slot]);
+        }
+
+        sizes[slot] = pick_size(random);
+        live[slot] = (unsigned char*)koi_tlsf_alloc(&tlsf, sizes[slot]);
+
+        if (live[slot] == nullptr) {
+            ++failures;
+        } else {
+            memset(live[slot], (int)slot, sizes[slot]);
+        }
+    }
+
+    CHECK(corrupted == 0u);
+    CHECK(failures == 0u);
+
+    for (unsigned char* ptr : live) {
+        koi_tlsf_free(&tlsf, ptr);
+    }
+
+    // every block merged back
+    void* ptr = koi_tlsf_alloc(&tlsf, (tlsf.bytes - 2u * koi_tlsf_get_header_size()) / 16u * 15u);
+    CHECK((ptr != nullptr));
+}
+
+
+TEST_CASE("TLSF Calloc", "[TLSF]") {
+    static char buffer[4096u];
+    koi_tlsf_t tlsf;
+    REQUIRE(koi_tlsf_init(&tlsf, buffer, sizeof(buffer)) == 1);
+
+    char* ptr = (char*)koi_tlsf_alloc(&tlsf, 100u);
+    REQUIRE(ptr != nullptr);
+    memset(ptr, 'A', 100u);
+
+    char* freed = ptr;
+    koi_tlsf_free(&tlsf, ptr);
+
+    // reuses the freed block, zeroed
+    ptr = (char*)koi_tlsf_calloc(&tlsf, 10u, 10u);
+    CHECK((ptr == freed));
+    for (size_t i = 0u; i < 100u; ++i) {
+        CHECK(ptr[i] == '\0');
+    }
+
+    koi_tlsf_free(&tlsf, ptr);
+
+    // the total size overflowing fails instead of allocating too little
+    CHECK((koi_tlsf_calloc(&tlsf, SIZE_MAX / 2u, 4u) == nullptr));
+    CHECK((koi_tlsf_calloc(&tlsf, 0u, 10u) == nullptr));
+}
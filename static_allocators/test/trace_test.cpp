@@ -0,0 +1,121 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Rudy Fisher (kiyasui-hito)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "static_allocators/allocator.h"
+#include "static_allocators/trace.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <vector>
+
+
+static const char* const trace_path = "koi_trace_test.bin";
+
+
+TEST_CASE("Trace Round Trip", "[Trace]") {
+    Koi::TraceWriter writer;
+    REQUIRE(writer.open(trace_path));
+
+    writer.record(3u, 100u);
+    writer.record(7u, 4096u);
+    writer.record(3u, 0u);
+    writer.close();
+
+    // records after closing are dropped
+    writer.record(7u, 0u);
+
+    std::vector<Koi::TraceRecord> records;
+    REQUIRE(Koi::read_trace(trace_path, records));
+    REQUIRE(records.size() == 3u);
+
+    CHECK(records[0u].id == 3u);
+    CHECK(records[0u].size == 100u);
+    CHECK(records[1u].id == 7u);
+    CHECK(records[1u].size == 4096u);
+    CHECK(records[2u].id == 3u);
+    CHECK(records[2u].size == 0u);
+    CHECK(records[0u].timestamp <= records[1u].timestamp);
+    CHECK(records[1u].timestamp <= records[2u].timestamp);
+
+    std::remove(trace_path);
+}
+
+
+TEST_CASE("Trace Invalid File", "[Trace]") {
+    FILE* file = fopen(trace_path, "wb");
+    REQUIRE(file != nullptr);
+    fputs("not a trace", file);
+    fclose(file);
+
+    std::vector<Koi::TraceRecord> records;
+    CHECK_FALSE(Koi::read_trace(trace_path, records));
+    CHECK_FALSE(Koi::read_trace("koi_trace_test_missing.bin", records));
+
+    std::remove(trace_path);
+}
+
+
+#if KOI_POOL_TRACE
+TEST_CASE("Trace Pool", "[Trace]") {
+    alignas(16) static char buffer[64u * KOI_BLOCK_SIZE];
+    koi_pool_t pool;
+    REQUIRE(koi_pool_init(&pool, buffer, sizeof(buffer)) == 1);
+
+    Koi::TraceWriter writer;
+    REQUIRE(writer.open(trace_path));
+    koi_pool_set_trace(&pool, Koi::TraceWriter::callback, &writer);
+
+    void* first = koi_pool_alloc(&pool, 100u);
+    void* second = koi_pool_alloc(&pool, 500u);
+    first = koi_pool_realloc(&pool, first, 90u);
+    koi_pool_free(&pool, second);
+
+    // invalid frees and failed allocations aren't recorded
+    koi_pool_free(&pool, buffer);
+    CHECK((koi_pool_alloc(&pool, sizeof(buffer)) == nullptr));
+
+    koi_pool_set_trace(&pool, nullptr, nullptr);
+    koi_pool_free(&pool, first);
+    writer.close();
+
+    std::vector<Koi::TraceRecord> records;
+    REQUIRE(Koi::read_trace(trace_path, records));
+    REQUIRE(records.size() == 5u);
+
+    // resizing in place is a free and an allocation of the same id
+    CHECK(records[0u].size == 100u);
+    CHECK(records[1u].size == 500u);
+    CHECK(records[1u].id != records[0u].id);
+    CHECK(records[2u].id == records[0u].id);
+    CHECK(records[2u].size == 0u);
+    CHECK(records[3u].id == records[0u].id);
+    CHECK(records[3u].size == 90u);
+    CHECK(records[4u].id == records[1u].id);
+    CHECK(records[4u].size == 0u);
+
+    std::remove(trace_path);
+}
+#endif